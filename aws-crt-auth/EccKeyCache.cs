@@ -0,0 +1,66 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Runtime.InteropServices;
+
+namespace Aws.Crt.Auth
+{
+    /*
+     * Process wide, bounded LRU cache of the SigV4a ECC keys derived from an access key and secret.  SIGV4A signing
+     * with AwsSigningConfig.CacheEccKeys set uses it, so that only the first signing with a set of credentials pays
+     * for the key derivation.
+     */
+    public static class AwsEccKeyCache
+    {
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthEccKeyCacheGetStats(
+                                    [Out, MarshalAs(UnmanagedType.LPArray, SizeConst = 3)] UInt64[] stats);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthEccKeyCacheClear();
+
+            public static AwsDotnetAuthEccKeyCacheGetStats GetStats = NativeAPI.Bind<AwsDotnetAuthEccKeyCacheGetStats>("aws_dotnet_auth_ecc_key_cache_get_stats");
+
+            public static AwsDotnetAuthEccKeyCacheClear Clear = NativeAPI.Bind<AwsDotnetAuthEccKeyCacheClear>("aws_dotnet_auth_ecc_key_cache_clear");
+
+            private static LibraryHandle library = new LibraryHandle();
+        }
+
+        // Indices into the stats output of aws_dotnet_auth_ecc_key_cache_get_stats
+        private const int HitsIndex = 0;
+        private const int MissesIndex = 1;
+        private const int CountIndex = 2;
+
+        // Discards every cached key and resets the counters
+        public static void Clear()
+        {
+            API.Clear();
+        }
+
+        public static ulong Hits
+        {
+            get { return Stats()[HitsIndex]; }
+        }
+
+        public static ulong Misses
+        {
+            get { return Stats()[MissesIndex]; }
+        }
+
+        public static ulong Count
+        {
+            get { return Stats()[CountIndex]; }
+        }
+
+        private static ulong[] Stats()
+        {
+            var stats = new ulong[3];
+            API.GetStats(stats);
+            return stats;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Aws.Crt;
+
+namespace Aws.Crt.Auth
+{
+    /*
+     * Verifies SigV4a signatures against one public key.  The key is parsed and validated once, when the verifier is
+     * created, instead of on every verification as AwsSigner.VerifyV4aSignature does.  A verifier may be used from
+     * several threads at once.
+     */
+    public class AwsSigV4aVerifier
+    {
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate Handle AwsDotnetAuthSigV4aVerifierNew(
+                                    [MarshalAs(UnmanagedType.LPStr)] string ecc_pub_x,
+                                    [MarshalAs(UnmanagedType.LPStr)] string ecc_pub_y);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSigV4aVerifierDestroy(IntPtr verifier);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            internal delegate bool AwsDotnetAuthSigV4aVerifierVerify(
+                                    Handle verifier,
+                                    byte[] string_to_sign,
+                                    UInt32 string_to_sign_size,
+                                    byte[] signature,
+                                    UInt32 signature_size);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSigV4aVerifierVerifyBatch(
+                                    Handle verifier,
+                                    byte[] strings_to_sign,
+                                    int[] string_offsets,
+                                    int[] string_lengths,
+                                    byte[] signatures,
+                                    int[] signature_offsets,
+                                    int[] signature_lengths,
+                                    UInt32 start,
+                                    UInt32 count,
+                                    [In, Out] byte[] results);
+
+            public static AwsDotnetAuthSigV4aVerifierNew MakeNew = NativeAPI.Bind<AwsDotnetAuthSigV4aVerifierNew>("aws_dotnet_auth_sigv4a_verifier_new");
+
+            public static AwsDotnetAuthSigV4aVerifierDestroy Destroy = NativeAPI.Bind<AwsDotnetAuthSigV4aVerifierDestroy>("aws_dotnet_auth_sigv4a_verifier_destroy");
+
+            public static AwsDotnetAuthSigV4aVerifierVerify Verify = NativeAPI.Bind<AwsDotnetAuthSigV4aVerifierVerify>("aws_dotnet_auth_sigv4a_verifier_verify");
+
+            public static AwsDotnetAuthSigV4aVerifierVerifyBatch VerifyBatch = NativeAPI.Bind<AwsDotnetAuthSigV4aVerifierVerifyBatch>("aws_dotnet_auth_sigv4a_verifier_verify_batch");
+
+            private static LibraryHandle library = new LibraryHandle();
+        }
+
+        public class Handle : CRT.Handle
+        {
+            protected override bool ReleaseHandle()
+            {
+                API.Destroy(handle);
+                return true;
+            }
+        }
+
+        /* Batches smaller than this per thread are not worth a thread of their own */
+        public const int ParallelBatchMinimumCount = 16;
+
+        public Handle NativeHandle { get; private set; }
+
+        // eccPubX and eccPubY are the hex encoded coordinates of the public key; an invalid key throws NativeException
+        public AwsSigV4aVerifier(String eccPubX, String eccPubY)
+        {
+            if (eccPubX == null)
+                throw new ArgumentNullException("eccPubX");
+            if (eccPubY == null)
+                throw new ArgumentNullException("eccPubY");
+
+            NativeHandle = API.MakeNew(eccPubX, eccPubY);
+        }
+
+        public bool Verify(String stringToSign, byte[] signature)
+        {
+            if (stringToSign == null)
+                throw new ArgumentNullException("stringToSign");
+            if (signature == null)
+                throw new ArgumentNullException("signature");
+
+            byte[] stringToSignBytes = Encoding.UTF8.GetBytes(stringToSign);
+            return API.Verify(NativeHandle, stringToSignBytes, (uint)stringToSignBytes.Length, signature, (uint)signature.Length);
+        }
+
+        /*
+         * Verifies signatures[i] against stringsToSign[i] for every i.  threadCount <= 0 uses one thread per
+         * processor; each thread verifies at least ParallelBatchMinimumCount records, so small batches run on the
+         * calling thread alone.
+         */
+        public bool[] VerifyBatch(String[] stringsToSign, byte[][] signatures, int threadCount = 1)
+        {
+            if (stringsToSign == null)
+                throw new ArgumentNullException("stringsToSign");
+            if (signatures == null)
+                throw new ArgumentNullException("signatures");
+            if (stringsToSign.Length != signatures.Length)
+                throw new ArgumentException("stringsToSign and signatures must have the same number of records", "signatures");
+
+            int count = stringsToSign.Length;
+            var stringOffsets = new int[count];
+            var stringLengths = new int[count];
+            var signatureOffsets = new int[count];
+            var signatureLengths = new int[count];
+
+            int stringsSize = 0;
+            int signaturesSize = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (stringsToSign[i] == null)
+                    throw new ArgumentNullException("stringsToSign", "stringsToSign must not contain null");
+                if (signatures[i] == null)
+                    throw new ArgumentNullException("signatures", "signatures must not contain null");
+
+                // A batch whose records add up to more than an array can hold throws OverflowException
+                stringOffsets[i] = stringsSize;
+                stringLengths[i] = Encoding.UTF8.GetByteCount(stringsToSign[i]);
+                stringsSize = checked(stringsSize + stringLengths[i]);
+
+                signatureOffsets[i] = signaturesSize;
+                signatureLengths[i] = signatures[i].Length;
+                signaturesSize = checked(signaturesSize + signatureLengths[i]);
+            }
+
+            var stringBuffer = new byte[stringsSize];
+            var signatureBuffer = new byte[signaturesSize];
+            for (int i = 0; i < count; ++i)
+            {
+                Encoding.UTF8.GetBytes(stringsToSign[i], 0, stringsToSign[i].Length, stringBuffer, stringOffsets[i]);
+                Buffer.BlockCopy(signatures[i], 0, signatureBuffer, signatureOffsets[i], signatureLengths[i]);
+            }
+
+            var verified = new byte[count];
+            RunRanges(count, threadCount, (start, rangeCount) => {
+                API.VerifyBatch(NativeHandle, stringBuffer, stringOffsets, stringLengths, signatureBuffer,
+                    signatureOffsets, signatureLengths, (uint)start, (uint)rangeCount, verified);
+            });
+
+            var results = new bool[count];
+            for (int i = 0; i < count; ++i)
+            {
+                results[i] = verified[i] != 0;
+            }
+            return results;
+        }
+
+        // Splits [0, count) into contiguous ranges and runs all but the first on new threads
+        private static void RunRanges(int count, int threadCount, Action<int, int> verifyRange)
+        {
+            if (threadCount <= 0)
+            {
+                threadCount = Environment.ProcessorCount;
+            }
+            int ranges = Math.Max(1, Math.Min(threadCount, count / ParallelBatchMinimumCount));
+
+            // Range i is [rangeStart(i), rangeStart(i + 1))
+            Func<int, int> rangeStart = (range) => (int)((long)count * range / ranges);
+            ParallelParts.Run(ranges, (range) => verifyRange(rangeStart(range), rangeStart(range + 1) - rangeStart(range)));
+        }
+    }
+}
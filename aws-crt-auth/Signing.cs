@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 using System;
+using System.Collections.Generic;
 using System.IO;
 using System.Runtime.InteropServices;
 
@@ -58,6 +59,12 @@ namespace Aws.Crt.Auth
         public AwsSignedBodyHeaderType SignedBodyHeader { get; set; }
         public ulong ExpirationInSeconds { get; set; }
 
+        /*
+         * For SIGV4A, sign with the SigV4a ECC key derived from these credentials by an earlier signing, if there was
+         * one (see AwsEccKeyCache).  AwsPreparedSigningConfig always derives the key just once.
+         */
+        public bool CacheEccKeys { get; set; }
+
         public AwsSigningConfig() {
             Algorithm = AwsSigningAlgorithm.SIGV4;
             SignatureType = AwsSignatureType.HTTP_REQUEST_VIA_HEADERS;
@@ -67,6 +74,57 @@ namespace Aws.Crt.Auth
             OmitSessionToken = false;
             SignedBodyHeader = AwsSignedBodyHeaderType.NONE;
             ExpirationInSeconds = 0;
+            CacheEccKeys = false;
+        }
+    }
+
+    /*
+     * A signing config that is validated and converted to native form once, including its credentials, and then
+     * reused for many signings.  Signing with it only passes the timestamp and per-request overrides to native code.
+     */
+    public class AwsPreparedSigningConfig {
+
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate Handle AwsDotnetSigningConfigNew([In] AwsSigner.AwsSigningConfigNative signing_config);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetSigningConfigDestroy(IntPtr signing_config);
+
+            public static AwsDotnetSigningConfigNew MakeNew = NativeAPI.Bind<AwsDotnetSigningConfigNew>("aws_dotnet_signing_config_new");
+
+            public static AwsDotnetSigningConfigDestroy Destroy = NativeAPI.Bind<AwsDotnetSigningConfigDestroy>("aws_dotnet_signing_config_destroy");
+
+            private static LibraryHandle library = new LibraryHandle();
+        }
+
+        public class Handle : CRT.Handle
+        {
+            protected override bool ReleaseHandle()
+            {
+                API.Destroy(handle);
+                return true;
+            }
+        }
+
+        public Handle NativeHandle { get; private set; }
+
+        public AwsSigningAlgorithm Algorithm { get; private set; }
+        public AwsSignatureType SignatureType { get; private set; }
+
+        /* The native config calls this for as long as it lives, so it must not be collected before it */
+        internal ShouldSignHeaderCallback ShouldSignHeader { get; private set; }
+
+        public AwsPreparedSigningConfig(AwsSigningConfig config) {
+            if (config == null) {
+                throw new ArgumentNullException("config");
+            }
+
+            Algorithm = config.Algorithm;
+            SignatureType = config.SignatureType;
+            ShouldSignHeader = config.ShouldSignHeader;
+            NativeHandle = API.MakeNew(new AwsSigner.AwsSigningConfigNative(config));
         }
     }
 
@@ -122,13 +180,16 @@ namespace Aws.Crt.Auth
             [MarshalAs(UnmanagedType.U8)]
             public ulong ExpirationInSeconds;
 
+            [MarshalAs(UnmanagedType.U1)]
+            public bool CacheEccKeys;
+
             public AwsSigningConfigNative(AwsSigningConfig config)
             {
                 Algorithm = config.Algorithm;
                 SignatureType = config.SignatureType;
                 Region = config.Region;
                 Service = config.Service;
-                MillisecondsSinceEpoch = MillisecondsSinceEpoch = (long)(config.Timestamp.ToUniversalTime() - new DateTime(1970, 1, 1, 0, 0, 0, DateTimeKind.Utc)).TotalMilliseconds;
+                MillisecondsSinceEpoch = ToMillisecondsSinceEpoch(config.Timestamp);
 
                 Credentials creds = config.Credentials;
                 if (creds != null) {
@@ -148,17 +209,39 @@ namespace Aws.Crt.Auth
                 SignedBodyValue = config.SignedBodyValue;
                 SignedBodyHeader = config.SignedBodyHeader;
                 ExpirationInSeconds = config.ExpirationInSeconds;
+                CacheEccKeys = config.CacheEccKeys;
             }
         }
 
+        internal static long ToMillisecondsSinceEpoch(DateTimeOffset timestamp)
+        {
+            return (long)(timestamp.ToUniversalTime() - new DateTime(1970, 1, 1, 0, 0, 0, DateTimeKind.Utc)).TotalMilliseconds;
+        }
+
         public class CrtSigningResult {
             public byte[] Signature;
 
             public HttpRequest SignedRequest;
         }
 
+        /*
+         * Results of a batch signing, in request order.  Results[i] is null when signing request i failed, with the
+         * reason in ErrorCodes[i].
+         */
+        public class CrtBatchSigningResult {
+            public CrtSigningResult[] Results;
+
+            public int[] ErrorCodes;
+        }
+
         internal static class API
         {
+            internal delegate void OnBatchSigningCompleteCallback(
+                UInt64 id,
+                Int32 errorCode,
+                [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3)] byte[] results,
+                UInt64 resultsSize);
+
             internal delegate void OnSigningCompleteCallback(
                 UInt64 id,
                 Int32 errorCode,
@@ -172,7 +255,7 @@ namespace Aws.Crt.Auth
             internal delegate void AwsDotnetAuthSignHttpRequest(
                                     [MarshalAs(UnmanagedType.LPStr)] string method,
                                     [MarshalAs(UnmanagedType.LPStr)] string uri,
-                                    [In] HttpHeader[] headers,
+                                    [In] HttpHeaderNative[] headers,
                                     UInt32 header_count,
                                     [In] CrtStreamWrapper.DelegateTable stream_delegate_table,
                                     [In] AwsSigningConfigNative signing_config,
@@ -196,7 +279,7 @@ namespace Aws.Crt.Auth
                                     OnSigningCompleteCallback completion_callback_delegate);
 
             internal delegate void AwsDotnetAuthSignTrailingHeaders(
-                                    [In] HttpHeader[] headers,
+                                    [In] HttpHeaderNative[] headers,
                                     UInt32 header_count,
                                     [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] signature_buffer,
                                     UInt32 signature_buffer_length,
@@ -204,6 +287,50 @@ namespace Aws.Crt.Auth
                                     UInt64 future_id,
                                     OnSigningCompleteCallback completion_callback_delegate);
 
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSignHttpRequestWithConfig(
+                                    [MarshalAs(UnmanagedType.LPStr)] string method,
+                                    [MarshalAs(UnmanagedType.LPStr)] string uri,
+                                    [In] HttpHeaderNative[] headers,
+                                    UInt32 header_count,
+                                    [In] CrtStreamWrapper.DelegateTable stream_delegate_table,
+                                    IntPtr signing_config,
+                                    Int64 milliseconds_since_epoch,
+                                    [MarshalAs(UnmanagedType.LPStr)] string signed_body_value,
+                                    UInt64 expiration_in_seconds,
+                                    UInt64 future_id,
+                                    OnSigningCompleteCallback completion_callback_delegate);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSignCanonicalRequestWithConfig(
+                                    [MarshalAs(UnmanagedType.LPStr)] string canonical_request,
+                                    IntPtr signing_config,
+                                    Int64 milliseconds_since_epoch,
+                                    UInt64 future_id,
+                                    OnSigningCompleteCallback completion_callback_delegate);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSignChunkWithConfig(
+                                    [In] CrtStreamWrapper.DelegateTable stream_delegate_table,
+                                    [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] signature_buffer,
+                                    UInt32 signature_buffer_length,
+                                    IntPtr signing_config,
+                                    Int64 milliseconds_since_epoch,
+                                    UInt64 future_id,
+                                    OnSigningCompleteCallback completion_callback_delegate);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSignHttpRequestsWithConfig(
+                                    UInt32 request_count,
+                                    [In, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] string[] methods,
+                                    [In, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] string[] uris,
+                                    [In] HttpHeaderNative[] headers,
+                                    [In] UInt32[] header_counts,
+                                    IntPtr signing_config,
+                                    Int64 milliseconds_since_epoch,
+                                    UInt64 future_id,
+                                    OnBatchSigningCompleteCallback completion_callback_delegate);
+
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
             internal delegate bool AwsDotnetAuthVerifyV4aCanonicalSigning(
                                     [MarshalAs(UnmanagedType.LPStr)] string canonical_request,
@@ -228,6 +355,14 @@ namespace Aws.Crt.Auth
 
             public static AwsDotnetAuthSignTrailingHeaders SignTrailingHeadersNative = NativeAPI.Bind<AwsDotnetAuthSignTrailingHeaders>("aws_dotnet_auth_sign_trailing_headers");
 
+            public static AwsDotnetAuthSignHttpRequestWithConfig SignRequestWithConfigNative = NativeAPI.Bind<AwsDotnetAuthSignHttpRequestWithConfig>("aws_dotnet_auth_sign_http_request_with_config");
+
+            public static AwsDotnetAuthSignCanonicalRequestWithConfig SignCanonicalRequestWithConfigNative = NativeAPI.Bind<AwsDotnetAuthSignCanonicalRequestWithConfig>("aws_dotnet_auth_sign_canonical_request_with_config");
+
+            public static AwsDotnetAuthSignChunkWithConfig SignChunkWithConfigNative = NativeAPI.Bind<AwsDotnetAuthSignChunkWithConfig>("aws_dotnet_auth_sign_chunk_with_config");
+
+            public static AwsDotnetAuthSignHttpRequestsWithConfig SignRequestsWithConfigNative = NativeAPI.Bind<AwsDotnetAuthSignHttpRequestsWithConfig>("aws_dotnet_auth_sign_http_requests_with_config");
+
             public static AwsDotnetAuthVerifyV4aCanonicalSigning VerifyV4aCanonicalSigningNative = NativeAPI.Bind<AwsDotnetAuthVerifyV4aCanonicalSigning>("aws_dotnet_auth_verify_v4a_canonical_signing");
 
             public static AwsDotnetAuthVerifyV4aSignature VerifyV4aSignatureNative = NativeAPI.Bind<AwsDotnetAuthVerifyV4aSignature>("aws_dotnet_auth_verify_v4a_signature");
@@ -240,6 +375,8 @@ namespace Aws.Crt.Auth
 
             public static OnSigningCompleteCallback OnTrailingHeadersSigningComplete = AwsSigner.OnTrailingHeadersSigningComplete;
 
+            public static OnBatchSigningCompleteCallback OnBatchSigningComplete = AwsSigner.OnBatchSigningComplete;
+
             private static LibraryHandle library = new LibraryHandle();
         }
 
@@ -249,11 +386,13 @@ namespace Aws.Crt.Auth
             public CrtResult<CrtSigningResult> Result = new CrtResult<CrtSigningResult>();
             public CrtStreamWrapper BodyStream;
             public ShouldSignHeaderCallback ShouldSignHeader;
+            public AwsPreparedSigningConfig PreparedConfig;
         }
 
         private class CanonicalRequestSigningCallbackData
         {
             public String OriginalCanonicalRequest;
+            public AwsPreparedSigningConfig PreparedConfig;
             public CrtResult<CrtSigningResult> Result = new CrtResult<CrtSigningResult>();
         }
 
@@ -263,6 +402,8 @@ namespace Aws.Crt.Auth
 
             public byte[] PreviousSignature;
 
+            public AwsPreparedSigningConfig PreparedConfig;
+
             public CrtResult<CrtSigningResult> Result = new CrtResult<CrtSigningResult>();
         }
 
@@ -276,10 +417,19 @@ namespace Aws.Crt.Auth
             public CrtResult<CrtSigningResult> Result = new CrtResult<CrtSigningResult>();
         }
 
+        private class BatchSigningCallbackData
+        {
+            public HttpRequest[] OriginalRequests;
+            public AwsPreparedSigningConfig PreparedConfig;
+            /* Completes the caller's result from the batch error code and encoded results */
+            public Action<int, byte[]> Complete;
+        }
+
         private static StrongReferenceVendor<HttpRequestSigningCallbackData> PendingHttpRequestSignings = new StrongReferenceVendor<HttpRequestSigningCallbackData>();
         private static StrongReferenceVendor<CanonicalRequestSigningCallbackData> PendingCanonicalRequestSignings = new StrongReferenceVendor<CanonicalRequestSigningCallbackData>();
         private static StrongReferenceVendor<ChunkSigningCallbackData> PendingChunkSignings = new StrongReferenceVendor<ChunkSigningCallbackData>();
         private static StrongReferenceVendor<TrailingHeadersSigningCallbackData> PendingTrailingHeadersSignings = new StrongReferenceVendor<TrailingHeadersSigningCallbackData>();
+        private static StrongReferenceVendor<BatchSigningCallbackData> PendingBatchSignings = new StrongReferenceVendor<BatchSigningCallbackData>();
 
         private static void OnHttpRequestSigningComplete(ulong id, int errorCode, byte[] signatureBuffer, ulong signatureBufferSize, string uri, HttpHeaderNative[] headers, uint headerCount)
         {
@@ -300,6 +450,8 @@ namespace Aws.Crt.Auth
                 signedRequest.Uri = uri;
                 signedRequest.Headers = Array.ConvertAll(headers, header => new HttpHeader(header.Name, header.Value));
                 signedRequest.BodyStream = sourceRequest.BodyStream;
+                signedRequest.BodyFile = sourceRequest.BodyFile;
+                signedRequest.AsyncBodyReads = sourceRequest.AsyncBodyReads;
 
                 CrtSigningResult result = new CrtSigningResult();
                 result.SignedRequest = signedRequest;
@@ -326,24 +478,264 @@ namespace Aws.Crt.Auth
 
             var nativeConfig = new AwsSigningConfigNative(signingConfig);
 
-            uint headerCount = 0;
-            if (request.Headers != null)
+            HttpRequestSigningCallbackData callback = new HttpRequestSigningCallbackData();
+            callback.OriginalRequest = request; /* needed to build final signed request */
+            callback.ShouldSignHeader = signingConfig.ShouldSignHeader; /* prevent GC while signing */
+            callback.BodyStream = new CrtStreamWrapper(request.BodyStream, request.BodyFile);
+
+            ulong id = PendingHttpRequestSignings.AcquireStrongReference(callback);
+
+            using (var headers = PackedHttpHeaders.Pack(request.Headers))
+            {
+                API.SignRequestNative(request.Method, request.Uri, headers.Headers, headers.Count, callback.BodyStream.Delegates, nativeConfig, id, API.OnHttpRequestSigningComplete);
+            }
+
+            return callback.Result;
+        }
+
+        /*
+         * Signs with a prepared config, which is not converted or validated again.  signedBodyValue and
+         * expirationInSeconds override the prepared config's when set.
+         */
+        public static CrtResult<CrtSigningResult> SignHttpRequest(HttpRequest request, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp,
+                                                                  string signedBodyValue = null, ulong expirationInSeconds = 0)
+        {
+            if (request == null || signingConfig == null)
+            {
+                throw new CrtException("Null argument passed to SignHttpRequest");
+            }
+
+            if (request.BodyStream != null)
             {
-                headerCount = (uint)request.Headers.Length;
+                if (!request.BodyStream.CanSeek)
+                {
+                    throw new CrtException("Http request payload stream must be seekable in order to be signed");
+                }
             }
 
             HttpRequestSigningCallbackData callback = new HttpRequestSigningCallbackData();
-            callback.OriginalRequest = request; /* needed to build final signed request */
-            callback.ShouldSignHeader = signingConfig.ShouldSignHeader; /* prevent GC while signing */
-            callback.BodyStream = new CrtStreamWrapper(request.BodyStream);
+            callback.OriginalRequest = request;
+            callback.PreparedConfig = signingConfig; /* prevent GC while signing */
+            callback.BodyStream = new CrtStreamWrapper(request.BodyStream, request.BodyFile);
 
             ulong id = PendingHttpRequestSignings.AcquireStrongReference(callback);
 
-            API.SignRequestNative(request.Method, request.Uri, request.Headers, headerCount, callback.BodyStream.Delegates, nativeConfig, id, API.OnHttpRequestSigningComplete);
+            using (var headers = PackedHttpHeaders.Pack(request.Headers))
+            {
+                API.SignRequestWithConfigNative(request.Method, request.Uri, headers.Headers, headers.Count, callback.BodyStream.Delegates,
+                    signingConfig.NativeHandle.DangerousGetHandle(), ToMillisecondsSinceEpoch(timestamp), signedBodyValue, expirationInSeconds,
+                    id, API.OnHttpRequestSigningComplete);
+            }
 
             return callback.Result;
         }
 
+        private static void OnBatchSigningComplete(ulong id, int errorCode, byte[] results, ulong resultsSize)
+        {
+            BatchSigningCallbackData callback = PendingBatchSignings.ReleaseStrongReference(id);
+            if (callback == null) {
+                return;
+            }
+
+            callback.Complete(errorCode, results ?? new byte[0]);
+        }
+
+        /* Reads the result records of aws_dotnet_auth_sign_http_requests_with_config */
+        private struct BatchResultReader
+        {
+            private byte[] results;
+            private int position;
+
+            public BatchResultReader(byte[] results)
+            {
+                this.results = results;
+                position = 0;
+            }
+
+            public int ReadInt()
+            {
+                int value = BitConverter.ToInt32(results, position);
+                position += 4;
+                return value;
+            }
+
+            public byte[] ReadBytes()
+            {
+                byte[] bytes = new byte[ReadInt()];
+                Buffer.BlockCopy(results, position, bytes, 0, bytes.Length);
+                position += bytes.Length;
+                return bytes;
+            }
+
+            public void Skip()
+            {
+                position += ReadInt();
+            }
+
+            public string ReadString()
+            {
+                int length = ReadInt();
+                string value = System.Text.Encoding.UTF8.GetString(results, position, length);
+                position += length;
+                return value;
+            }
+        }
+
+        private static void StartBatchSigning(HttpRequest[] requests, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp, BatchSigningCallbackData callback)
+        {
+            var methods = new string[requests.Length];
+            var uris = new string[requests.Length];
+            var headerCounts = new uint[requests.Length];
+            var headers = new List<HttpHeader>();
+            for (int i = 0; i < requests.Length; ++i)
+            {
+                HttpRequest request = requests[i];
+                if (request == null) {
+                    throw new CrtException("Null request passed to batch signing");
+                }
+
+                if (request.BodyStream != null || request.BodyFile != null) {
+                    throw new CrtException("Batch signing only supports requests without a body");
+                }
+
+                methods[i] = request.Method;
+                uris[i] = request.Uri;
+                if (request.Headers != null) {
+                    headerCounts[i] = (uint)request.Headers.Length;
+                    headers.AddRange(request.Headers);
+                }
+            }
+
+            callback.OriginalRequests = requests;
+            callback.PreparedConfig = signingConfig;
+
+            ulong id = PendingBatchSignings.AcquireStrongReference(callback);
+
+            using (var packedHeaders = PackedHttpHeaders.Pack(headers.ToArray()))
+            {
+                API.SignRequestsWithConfigNative((uint)requests.Length, methods, uris, packedHeaders.Headers, headerCounts,
+                    signingConfig.NativeHandle.DangerousGetHandle(), ToMillisecondsSinceEpoch(timestamp), id, API.OnBatchSigningComplete);
+            }
+        }
+
+        /*
+         * Signs many bodyless requests with one prepared config and timestamp in a single native call, completing
+         * once with every result.
+         */
+        public static CrtResult<CrtBatchSigningResult> SignHttpRequests(HttpRequest[] requests, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            if (requests == null || signingConfig == null)
+            {
+                throw new CrtException("Null argument passed to SignHttpRequests");
+            }
+
+            var result = new CrtResult<CrtBatchSigningResult>();
+            var callback = new BatchSigningCallbackData();
+            callback.Complete = (errorCode, results) => {
+                if (errorCode != 0) {
+                    result.CompleteExceptionally(new CrtException(errorCode));
+                    return;
+                }
+
+                var batchResult = new CrtBatchSigningResult();
+                batchResult.Results = new CrtSigningResult[requests.Length];
+                batchResult.ErrorCodes = new int[requests.Length];
+
+                // Runs on a native thread, so a malformed record must fail the result rather than escape
+                try
+                {
+                    var reader = new BatchResultReader(results);
+                    for (int i = 0; i < requests.Length; ++i)
+                    {
+                        batchResult.ErrorCodes[i] = reader.ReadInt();
+                        string uri = reader.ReadString();
+                        byte[] signature = reader.ReadBytes();
+                        var headers = new HttpHeader[reader.ReadInt()];
+                        for (int h = 0; h < headers.Length; ++h)
+                        {
+                            string name = reader.ReadString();
+                            headers[h] = new HttpHeader(name, reader.ReadString());
+                        }
+
+                        if (batchResult.ErrorCodes[i] == 0) {
+                            HttpRequest signedRequest = new HttpRequest();
+                            signedRequest.Method = requests[i].Method;
+                            signedRequest.Uri = uri;
+                            signedRequest.Headers = headers;
+
+                            CrtSigningResult signingResult = new CrtSigningResult();
+                            signingResult.SignedRequest = signedRequest;
+                            signingResult.Signature = signature;
+                            batchResult.Results[i] = signingResult;
+                        }
+                    }
+                }
+                catch (Exception ex)
+                {
+                    result.CompleteExceptionally(ex);
+                    return;
+                }
+
+                result.Complete(batchResult);
+            };
+
+            StartBatchSigning(requests, signingConfig, timestamp, callback);
+
+            return result;
+        }
+
+        /*
+         * Produces a presigned URL for each request in a single native call.  signingConfig must sign via query
+         * params, each URL is its request's Uri with the signing query params added.  Fails if any request fails.
+         */
+        public static CrtResult<string[]> PresignUrls(HttpRequest[] requests, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            if (requests == null || signingConfig == null)
+            {
+                throw new CrtException("Null argument passed to PresignUrls");
+            }
+
+            if (signingConfig.SignatureType != AwsSignatureType.HTTP_REQUEST_VIA_QUERY_PARAMS) {
+                throw new CrtException("Illegal signature type for presigning urls");
+            }
+
+            var result = new CrtResult<string[]>();
+            var callback = new BatchSigningCallbackData();
+            callback.Complete = (errorCode, results) => {
+                var urls = new string[requests.Length];
+                try
+                {
+                    var reader = new BatchResultReader(results);
+                    for (int i = 0; i < requests.Length && errorCode == 0; ++i)
+                    {
+                        errorCode = reader.ReadInt();
+                        urls[i] = reader.ReadString();
+                        reader.Skip();
+                        int headerCount = reader.ReadInt();
+                        for (int h = 0; h < 2 * headerCount; ++h)
+                        {
+                            reader.Skip();
+                        }
+                    }
+                }
+                catch (Exception ex)
+                {
+                    result.CompleteExceptionally(ex);
+                    return;
+                }
+
+                if (errorCode != 0) {
+                    result.CompleteExceptionally(new CrtException(errorCode));
+                } else {
+                    result.Complete(urls);
+                }
+            };
+
+            StartBatchSigning(requests, signingConfig, timestamp, callback);
+
+            return result;
+        }
+
         private static void OnCanonicalRequestSigningComplete(ulong id, int errorCode, byte[] signatureBuffer, ulong signatureBufferSize, string uri, HttpHeaderNative[] headers, uint headerCount)
         {
             CanonicalRequestSigningCallbackData callback = PendingCanonicalRequestSignings.ReleaseStrongReference(id);
@@ -396,6 +788,29 @@ namespace Aws.Crt.Auth
             return callback.Result;
         }
 
+        public static CrtResult<CrtSigningResult> SignCanonicalRequest(String canonicalRequest, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            if (canonicalRequest == null || signingConfig == null) {
+                throw new CrtException("Null argument passed to SignCanonicalRequest");
+            }
+
+            if (signingConfig.SignatureType != AwsSignatureType.CANONICAL_REQUEST_VIA_HEADERS &&
+                signingConfig.SignatureType != AwsSignatureType.CANONICAL_REQUEST_VIA_QUERY_PARAMS) {
+                throw new CrtException("Illegal signing type for canonical request signing");
+            }
+
+            CanonicalRequestSigningCallbackData callback = new CanonicalRequestSigningCallbackData();
+            callback.OriginalCanonicalRequest = canonicalRequest;
+            callback.PreparedConfig = signingConfig;
+
+            ulong id = PendingCanonicalRequestSignings.AcquireStrongReference(callback);
+
+            API.SignCanonicalRequestWithConfigNative(canonicalRequest, signingConfig.NativeHandle.DangerousGetHandle(), ToMillisecondsSinceEpoch(timestamp),
+                id, API.OnCanonicalRequestSigningComplete);
+
+            return callback.Result;
+        }
+
         private static void OnChunkSigningComplete(ulong id, int errorCode, byte[] signatureBuffer, ulong signatureBufferSize, string uri, HttpHeaderNative[] headers, uint headerCount)
         {
             ChunkSigningCallbackData callback = PendingChunkSignings.ReleaseStrongReference(id);
@@ -417,6 +832,17 @@ namespace Aws.Crt.Auth
         }
 
         public static CrtResult<CrtSigningResult> SignChunk(Stream chunkBodyStream, byte[] previousSignature, AwsSigningConfig signingConfig)
+        {
+            return SignChunk(new CrtStreamWrapper(chunkBodyStream), previousSignature, signingConfig);
+        }
+
+        // Signs a chunk that is a range of a file, read by native code
+        public static CrtResult<CrtSigningResult> SignFileChunk(CrtFileBody chunkBody, byte[] previousSignature, AwsSigningConfig signingConfig)
+        {
+            return SignChunk(new CrtStreamWrapper(null, chunkBody), previousSignature, signingConfig);
+        }
+
+        private static CrtResult<CrtSigningResult> SignChunk(CrtStreamWrapper chunkBody, byte[] previousSignature, AwsSigningConfig signingConfig)
         {
             if (previousSignature == null || signingConfig == null) {
                 throw new CrtException("Null argument passed to SignChunk");
@@ -429,7 +855,7 @@ namespace Aws.Crt.Auth
             var nativeConfig = new AwsSigningConfigNative(signingConfig);
 
             ChunkSigningCallbackData callback = new ChunkSigningCallbackData();
-            callback.OriginalChunkBodyStream = new CrtStreamWrapper(chunkBodyStream);
+            callback.OriginalChunkBodyStream = chunkBody;
             callback.PreviousSignature = previousSignature;
 
             ulong id = PendingChunkSignings.AcquireStrongReference(callback);
@@ -439,6 +865,39 @@ namespace Aws.Crt.Auth
             return callback.Result;
         }
 
+        public static CrtResult<CrtSigningResult> SignChunk(Stream chunkBodyStream, byte[] previousSignature, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            return SignChunk(new CrtStreamWrapper(chunkBodyStream), previousSignature, signingConfig, timestamp);
+        }
+
+        public static CrtResult<CrtSigningResult> SignFileChunk(CrtFileBody chunkBody, byte[] previousSignature, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            return SignChunk(new CrtStreamWrapper(null, chunkBody), previousSignature, signingConfig, timestamp);
+        }
+
+        private static CrtResult<CrtSigningResult> SignChunk(CrtStreamWrapper chunkBody, byte[] previousSignature, AwsPreparedSigningConfig signingConfig, DateTimeOffset timestamp)
+        {
+            if (previousSignature == null || signingConfig == null) {
+                throw new CrtException("Null argument passed to SignChunk");
+            }
+
+            if (signingConfig.SignatureType != AwsSignatureType.HTTP_REQUEST_CHUNK) {
+                throw new CrtException("Illegal signature type for chunked body signing");
+            }
+
+            ChunkSigningCallbackData callback = new ChunkSigningCallbackData();
+            callback.OriginalChunkBodyStream = chunkBody;
+            callback.PreviousSignature = previousSignature;
+            callback.PreparedConfig = signingConfig;
+
+            ulong id = PendingChunkSignings.AcquireStrongReference(callback);
+
+            API.SignChunkWithConfigNative(callback.OriginalChunkBodyStream.Delegates, callback.PreviousSignature, (uint) callback.PreviousSignature.Length,
+                signingConfig.NativeHandle.DangerousGetHandle(), ToMillisecondsSinceEpoch(timestamp), id, API.OnChunkSigningComplete);
+
+            return callback.Result;
+        }
+
         private static void OnTrailingHeadersSigningComplete(ulong id, int errorCode, byte[] signatureBuffer, ulong signatureBufferSize, string uri, HttpHeaderNative[] headers, uint headerCount)
         {
             TrailingHeadersSigningCallbackData callback = PendingTrailingHeadersSignings.ReleaseStrongReference(id);
@@ -469,11 +928,6 @@ namespace Aws.Crt.Auth
                 throw new CrtException("Illegal signature type for trailing headers signing");
             }
 
-            uint trailingHeaderCount = 0;
-            if (headers != null) {
-                trailingHeaderCount = (uint) headers.Length;
-            }
-
             var nativeConfig = new AwsSigningConfigNative(signingConfig);
 
             TrailingHeadersSigningCallbackData callback = new TrailingHeadersSigningCallbackData();
@@ -482,7 +936,10 @@ namespace Aws.Crt.Auth
 
             ulong id = PendingTrailingHeadersSignings.AcquireStrongReference(callback);
 
-            API.SignTrailingHeadersNative(callback.TrailingHeaders, trailingHeaderCount, callback.PreviousSignature, (uint) callback.PreviousSignature.Length, nativeConfig, id, API.OnTrailingHeadersSigningComplete);
+            using (var packedHeaders = PackedHttpHeaders.Pack(callback.TrailingHeaders))
+            {
+                API.SignTrailingHeadersNative(packedHeaders.Headers, packedHeaders.Count, callback.PreviousSignature, (uint) callback.PreviousSignature.Length, nativeConfig, id, API.OnTrailingHeadersSigningComplete);
+            }
 
             return callback.Result;
         }
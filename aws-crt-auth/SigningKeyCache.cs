@@ -0,0 +1,116 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Runtime.InteropServices;
+
+namespace Aws.Crt.Auth
+{
+    /*
+     * Process wide, bounded LRU cache of derived SigV4 signing keys, keyed by a digest of credentials, date, region and
+     * service. Deriving a signing key costs four HMACs. aws-c-auth can't be given a precomputed key, so AwsSigner
+     * always derives its own; the cache is for callers that compute SigV4 signatures themselves, such as S3 POST
+     * policies, with GetSigningKey. Disabled by default.
+     */
+    public static class AwsSigningKeyCache
+    {
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSigningKeyCacheConfigure(UInt32 capacity);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSigningKeyCacheGetStats(
+                                    [Out, MarshalAs(UnmanagedType.LPArray, SizeConst = 3)] UInt64[] stats);
+
+            public static AwsDotnetAuthSigningKeyCacheConfigure Configure = NativeAPI.Bind<AwsDotnetAuthSigningKeyCacheConfigure>("aws_dotnet_auth_signing_key_cache_configure");
+
+            public static AwsDotnetAuthSigningKeyCacheGetStats GetStats = NativeAPI.Bind<AwsDotnetAuthSigningKeyCacheGetStats>("aws_dotnet_auth_signing_key_cache_get_stats");
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void AwsDotnetAuthSigningKeyCacheGetKey(
+                                    [In] byte[] accessKeyId,
+                                    UInt32 accessKeyIdLength,
+                                    [In] byte[] secretAccessKey,
+                                    UInt32 secretAccessKeyLength,
+                                    Int64 millisecondsSinceEpoch,
+                                    [MarshalAs(UnmanagedType.LPStr)] string region,
+                                    [MarshalAs(UnmanagedType.LPStr)] string service,
+                                    [Out, MarshalAs(UnmanagedType.LPArray, SizeConst = SigningKeySize)] byte[] key);
+
+            public static AwsDotnetAuthSigningKeyCacheGetKey GetKey = NativeAPI.Bind<AwsDotnetAuthSigningKeyCacheGetKey>("aws_dotnet_auth_signing_key_cache_get_key");
+
+            private static LibraryHandle library = new LibraryHandle();
+        }
+
+        public const int DefaultCapacity = 256;
+
+        // Size of a SigV4 signing key, an HMAC-SHA256
+        public const int SigningKeySize = 32;
+
+        // Indices into the stats output of aws_dotnet_auth_signing_key_cache_get_stats
+        private const int HitsIndex = 0;
+        private const int MissesIndex = 1;
+        private const int CountIndex = 2;
+
+        // Enables the cache, or resizes it if it is already enabled. Cached keys are dropped and the counters reset.
+        public static void Enable(int capacity = DefaultCapacity)
+        {
+            if (capacity <= 0)
+            {
+                throw new ArgumentOutOfRangeException("capacity", capacity, "capacity must be positive");
+            }
+
+            API.Configure((uint)capacity);
+        }
+
+        // Disables the cache and securely discards every cached key
+        public static void Disable()
+        {
+            API.Configure(0);
+        }
+
+        /*
+         * The SigV4 signing key for the credentials, the UTC date of timestamp, region and service, from the cache if
+         * it is enabled and has it, otherwise derived (and cached, if it is enabled).
+         */
+        public static byte[] GetSigningKey(Credentials credentials, DateTimeOffset timestamp, string region, string service)
+        {
+            if (credentials == null || credentials.AccessKeyId == null || credentials.SecretAccessKey == null)
+                throw new ArgumentNullException("credentials");
+            if (region == null)
+                throw new ArgumentNullException("region");
+            if (service == null)
+                throw new ArgumentNullException("service");
+
+            var key = new byte[SigningKeySize];
+            API.GetKey(credentials.AccessKeyId, (uint)credentials.AccessKeyId.Length,
+                credentials.SecretAccessKey, (uint)credentials.SecretAccessKey.Length,
+                AwsSigner.ToMillisecondsSinceEpoch(timestamp), region, service, key);
+            return key;
+        }
+
+        public static ulong Hits
+        {
+            get { return Stats()[HitsIndex]; }
+        }
+
+        public static ulong Misses
+        {
+            get { return Stats()[MissesIndex]; }
+        }
+
+        public static ulong Count
+        {
+            get { return Stats()[CountIndex]; }
+        }
+
+        private static ulong[] Stats()
+        {
+            var stats = new ulong[3];
+            API.GetStats(stats);
+            return stats;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Aws.Crt.Cal
+{
+    [Flags]
+    public enum DigestAlgorithms
+    {
+        MD5 = 1,
+        SHA1 = 2,
+        SHA256 = 4,
+        CRC32 = 8,
+        CRC32C = 16,
+        CRC64NVME = 32,
+    }
+
+    // Result of DigestSet.digest, only the configured algorithms are set
+    public class DigestSetResults
+    {
+        public byte[] Md5 { get; internal set; }
+        public byte[] Sha1 { get; internal set; }
+        public byte[] Sha256 { get; internal set; }
+        public uint Crc32 { get; internal set; }
+        public uint Crc32c { get; internal set; }
+        public ulong Crc64nvme { get; internal set; }
+    }
+
+    /*
+     * Computes several hashes and CRCs over the same data in a single pass: each update is fed to every configured
+     * algorithm a cache sized chunk at a time, with one native call per update.
+     */
+    public class DigestSet
+    {
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate Handle aws_dotnet_digest_set_new(UInt32 algorithms);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_digest_set_update(IntPtr set, IntPtr buffer, UInt64 length);
+
+            // path is NUL terminated UTF-8
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_digest_set_update_file(IntPtr set, byte[] path, UInt64 offset, UInt64 length);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_digest_set_digest(IntPtr set,
+                        [Out, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.U1)] byte[] md5,
+                        [Out, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.U1)] byte[] sha1,
+                        [Out, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.U1)] byte[] sha256,
+                        [Out, MarshalAs(UnmanagedType.LPArray, SizeConst = 3)] UInt64[] crcs);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_digest_set_destroy(IntPtr set);
+
+            public static aws_dotnet_digest_set_new make_new = NativeAPI.Bind<aws_dotnet_digest_set_new>();
+            public static aws_dotnet_digest_set_update update = NativeAPI.Bind<aws_dotnet_digest_set_update>();
+            public static aws_dotnet_digest_set_update_file update_file = NativeAPI.Bind<aws_dotnet_digest_set_update_file>();
+            public static aws_dotnet_digest_set_digest digest = NativeAPI.Bind<aws_dotnet_digest_set_digest>();
+            public static aws_dotnet_digest_set_destroy destroy = NativeAPI.Bind<aws_dotnet_digest_set_destroy>();
+        }
+        private static LibraryHandle library = new LibraryHandle();
+
+        // Indices into the crcs output of aws_dotnet_digest_set_digest
+        private const int Crc32Index = 0;
+        private const int Crc32cIndex = 1;
+        private const int Crc64nvmeIndex = 2;
+
+        private Handle set;
+
+        public class Handle : CRT.Handle
+        {
+            protected override bool ReleaseHandle()
+            {
+                API.destroy(handle);
+                return true;
+            }
+        }
+
+        public DigestSet(DigestAlgorithms algorithms)
+        {
+            Algorithms = algorithms;
+            set = API.make_new((uint)algorithms);
+        }
+
+        public DigestAlgorithms Algorithms { get; private set; }
+
+        public void update(byte[] buffer)
+        {
+            update(buffer, 0, buffer?.Length ?? 0);
+        }
+        public void update(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            if (offset < 0 || offset > buffer.Length)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must be within the buffer");
+            if (count < 0 || count > buffer.Length - offset)
+                throw new ArgumentOutOfRangeException("count", count, "offset + count must be within the buffer");
+
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                API.update(set.DangerousGetHandle(), new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (ulong)count);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+        // For native memory, or pinned memory such as a fixed Span<byte>
+        public void update(IntPtr buffer, long length)
+        {
+            if (buffer == IntPtr.Zero && length != 0)
+                throw new ArgumentNullException("buffer");
+            if (length < 0)
+                throw new ArgumentOutOfRangeException("length", length, "length must not be negative");
+
+            API.update(set.DangerousGetHandle(), buffer, (ulong)length);
+        }
+        // Digests [offset, offset + length) of a file from a native memory mapping of it, -1 reads to the end of the file.
+        // Not safe for files that may be truncated meanwhile: on Linux and macOS reading a truncated mapping is SIGBUS.
+        public void updateFile(string path, long offset = 0, long length = -1)
+        {
+            if (path == null)
+                throw new ArgumentNullException("path");
+            if (offset < 0)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must not be negative");
+            if (length < -1)
+                throw new ArgumentOutOfRangeException("length", length, "length must be -1 or not negative");
+
+            API.update_file(set.DangerousGetHandle(), Encoding.UTF8.GetBytes(path + "\0"), (ulong)offset, length == -1 ? UInt64.MaxValue : (ulong)length);
+        }
+
+        // Finalizes every configured algorithm, the set can't be updated afterwards
+        public DigestSetResults digest()
+        {
+            byte[] md5 = Has(DigestAlgorithms.MD5) ? new byte[16] : null;
+            byte[] sha1 = Has(DigestAlgorithms.SHA1) ? new byte[20] : null;
+            byte[] sha256 = Has(DigestAlgorithms.SHA256) ? new byte[32] : null;
+            var crcs = new ulong[3];
+            API.digest(set.DangerousGetHandle(), md5, sha1, sha256, crcs);
+
+            return new DigestSetResults {
+                Md5 = md5,
+                Sha1 = sha1,
+                Sha256 = sha256,
+                Crc32 = (uint)crcs[Crc32Index],
+                Crc32c = (uint)crcs[Crc32cIndex],
+                Crc64nvme = crcs[Crc64nvmeIndex],
+            };
+        }
+
+        private bool Has(DigestAlgorithms algorithm)
+        {
+            return (Algorithms & algorithm) != 0;
+        }
+    }
+}
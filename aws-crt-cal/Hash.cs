@@ -5,6 +5,7 @@
 
 using System;
 using System.Runtime.InteropServices;
+using System.Text;
 
 namespace Aws.Crt.Cal
 {
@@ -22,23 +23,38 @@ namespace Aws.Crt.Cal
             public delegate Handle aws_dotnet_md5_new();
 
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
-            public delegate int aws_dotnet_hash_update(IntPtr hash,
-                                                      [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] buffer,
-                                                       UInt32 buffer_length);
+            public delegate void aws_dotnet_hash_update(IntPtr hash, IntPtr buffer, UInt64 buffer_length);
 
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
-            public delegate void aws_dotnet_hash_digest(IntPtr hash, UInt32 truncate, 
-                        [Out, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3, ArraySubType = UnmanagedType.U1)] byte[] buffer,
-                                                       UInt32 buffer_length);
+            public delegate void aws_dotnet_hash_reset(IntPtr hash);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_hash_digest(IntPtr hash, UInt32 truncate, IntPtr buffer, UInt32 buffer_length);
+
+            // path is NUL terminated UTF-8
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_hash_update_file(IntPtr hash, byte[] path, UInt64 offset, UInt64 length);
 
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
             public delegate void aws_dotnet_hash_destroy(IntPtr hash);
 
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_hash_batch([In, MarshalAs(UnmanagedType.LPArray)] byte[] buffer,
+                                                       [In, MarshalAs(UnmanagedType.LPArray)] Int32[] offsets,
+                                                       [In, MarshalAs(UnmanagedType.LPArray)] Int32[] lengths,
+                                                       UInt32 count,
+                                                       [Out, MarshalAs(UnmanagedType.LPArray)] byte[] digests);
+
             public static aws_dotnet_sha1_new sha1_new = NativeAPI.Bind<aws_dotnet_sha1_new>();
             public static aws_dotnet_sha256_new sha256_new = NativeAPI.Bind<aws_dotnet_sha256_new>();
             public static aws_dotnet_md5_new md5_new = NativeAPI.Bind<aws_dotnet_md5_new>();
             public static aws_dotnet_hash_update update = NativeAPI.Bind<aws_dotnet_hash_update>();
+            public static aws_dotnet_hash_reset reset = NativeAPI.Bind<aws_dotnet_hash_reset>();
+            public static aws_dotnet_hash_update_file update_file = NativeAPI.Bind<aws_dotnet_hash_update_file>();
             public static aws_dotnet_hash_digest digest = NativeAPI.Bind<aws_dotnet_hash_digest>();
+            public static aws_dotnet_hash_batch sha1_batch = NativeAPI.Bind<aws_dotnet_hash_batch>("aws_dotnet_sha1_batch");
+            public static aws_dotnet_hash_batch sha256_batch = NativeAPI.Bind<aws_dotnet_hash_batch>("aws_dotnet_sha256_batch");
+            public static aws_dotnet_hash_batch md5_batch = NativeAPI.Bind<aws_dotnet_hash_batch>("aws_dotnet_md5_batch");
             public static aws_dotnet_hash_destroy destroy = NativeAPI.Bind<aws_dotnet_hash_destroy>();
 
         }
@@ -47,6 +63,12 @@ namespace Aws.Crt.Cal
         private Handle hash;
         private uint length;
 
+        // MD5, SHA1 or SHA256
+        internal DigestAlgorithms Algorithm { get; private set; }
+
+        // Released to a HashPool and not since acquired; guarded by that pool
+        internal bool Pooled { get; set; }
+
         public class Handle : CRT.Handle
         {
             protected override bool ReleaseHandle()
@@ -56,33 +78,147 @@ namespace Aws.Crt.Cal
             }
         }
 
-        private Hash(Handle hash, uint length)
+        private Hash(Handle hash, uint length, DigestAlgorithms algorithm)
         {
             this.hash = hash;
             this.length = length;
+            Algorithm = algorithm;
         }
         public static Hash sha1()
         {
-            return new Hash(API.sha1_new(), 20);
+            return new Hash(API.sha1_new(), 20, DigestAlgorithms.SHA1);
         }
         public static Hash sha256()
         {
-            return new Hash(API.sha256_new(), 32);
+            return new Hash(API.sha256_new(), 32, DigestAlgorithms.SHA256);
         }
         public static Hash md5()
         {
-            return new Hash(API.md5_new(), 16);
+            return new Hash(API.md5_new(), 16, DigestAlgorithms.MD5);
+        }
+
+        /*
+         * Batch variants hash many small records of one buffer in a single native call: record i is
+         * [offsets[i], offsets[i] + lengths[i]) and its digest is written to digests at i * digest length.
+         */
+        public static void sha1Batch(byte[] buffer, int[] offsets, int[] lengths, byte[] digests)
+        {
+            ValidateBatch(buffer, offsets, lengths, digests, 20);
+            API.sha1_batch(buffer, offsets, lengths, (uint)offsets.Length, digests);
+        }
+        public static void sha256Batch(byte[] buffer, int[] offsets, int[] lengths, byte[] digests)
+        {
+            ValidateBatch(buffer, offsets, lengths, digests, 32);
+            API.sha256_batch(buffer, offsets, lengths, (uint)offsets.Length, digests);
+        }
+        public static void md5Batch(byte[] buffer, int[] offsets, int[] lengths, byte[] digests)
+        {
+            ValidateBatch(buffer, offsets, lengths, digests, 16);
+            API.md5_batch(buffer, offsets, lengths, (uint)offsets.Length, digests);
+        }
+
+        // Length of the digest in bytes
+        public int Length { get { return (int)this.length; } }
+
+        // Discards any input and finalization so the hash can be reused for a new message.  aws-c-cal can't reset a
+        // hash in place, so this replaces the native hash context.
+        public void reset()
+        {
+            API.reset(this.hash.DangerousGetHandle());
         }
 
         public void update(byte[] buffer)
         {
-            API.update(this.hash.DangerousGetHandle(), buffer, (uint)buffer.Length);
+            update(buffer, 0, buffer?.Length ?? 0);
+        }
+        public void update(byte[] buffer, int offset, int count)
+        {
+            ValidateRange(buffer, offset, count);
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                API.update(this.hash.DangerousGetHandle(), new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (ulong)count);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+        // For native memory, or pinned memory such as a fixed Span<byte>
+        public void update(IntPtr buffer, long length)
+        {
+            if (buffer == IntPtr.Zero && length != 0)
+                throw new ArgumentNullException("buffer");
+            if (length < 0)
+                throw new ArgumentOutOfRangeException("length", length, "length must not be negative");
+
+            API.update(this.hash.DangerousGetHandle(), buffer, (ulong)length);
+        }
+        // Hashes [offset, offset + length) of a file from a native memory mapping of it, -1 hashes to the end of the file.
+        // Off Windows, another process truncating the file mid-read crashes this one with SIGBUS; hash files that may
+        // shrink while being read with update instead.
+        public void updateFile(string path, long offset = 0, long length = -1)
+        {
+            if (path == null)
+                throw new ArgumentNullException("path");
+            if (offset < 0)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must not be negative");
+            if (length < -1)
+                throw new ArgumentOutOfRangeException("length", length, "length must be -1 or not negative");
+
+            API.update_file(this.hash.DangerousGetHandle(), Encoding.UTF8.GetBytes(path + "\0"), (ulong)offset, length == -1 ? UInt64.MaxValue : (ulong)length);
         }
         public byte[] digest(uint truncateTo = 0)
         {
             byte[] buffer = new byte[this.length];
-            API.digest(this.hash.DangerousGetHandle(), truncateTo, buffer, this.length);
+            digest(buffer, 0, truncateTo);
             return buffer;
         }
+        // Writes the digest into output at offset without allocating, and returns the number of bytes written
+        public int digest(byte[] output, int offset, uint truncateTo = 0)
+        {
+            int digestLength = (truncateTo == 0 || truncateTo > this.length) ? (int)this.length : (int)truncateTo;
+            ValidateRange(output, offset, digestLength);
+            GCHandle pin = GCHandle.Alloc(output, GCHandleType.Pinned);
+            try
+            {
+                API.digest(this.hash.DangerousGetHandle(), truncateTo, new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (uint)(output.Length - offset));
+            }
+            finally
+            {
+                pin.Free();
+            }
+            return digestLength;
+        }
+
+        private static void ValidateBatch(byte[] buffer, int[] offsets, int[] lengths, byte[] digests, int digestLength)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            if (offsets == null)
+                throw new ArgumentNullException("offsets");
+            if (lengths == null)
+                throw new ArgumentNullException("lengths");
+            if (digests == null)
+                throw new ArgumentNullException("digests");
+            if (offsets.Length != lengths.Length)
+                throw new ArgumentException("offsets and lengths must have the same number of records", "lengths");
+            if (digests.Length < (long)offsets.Length * digestLength)
+                throw new ArgumentException("digests is too small for every record", "digests");
+            for (int i = 0; i < offsets.Length; ++i)
+            {
+                ValidateRange(buffer, offsets[i], lengths[i]);
+            }
+        }
+
+        private static void ValidateRange(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            if (offset < 0 || offset > buffer.Length)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must be within the buffer");
+            if (count < 0 || count > buffer.Length - offset)
+                throw new ArgumentOutOfRangeException("count", count, "offset + count must be within the buffer");
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+using System;
+using System.Collections.Generic;
+
+namespace Aws.Crt.Cal
+{
+    /*
+     * Thread safe pool of reusable hashes of one algorithm, to avoid allocating a Hash and its SafeHandle for every
+     * message when hashing many small ones.  Hashes are reset when released, so acquire always returns a hash ready
+     * for a new message.  Resetting still allocates a new native hash context, as aws-c-cal has no way to reset one in
+     * place, so the pool saves the managed allocations and handle finalization but not that one.
+     */
+    public class HashPool
+    {
+        public const int DefaultMaxPooled = 64;
+
+        public static readonly HashPool Sha1 = new HashPool(DigestAlgorithms.SHA1);
+        public static readonly HashPool Sha256 = new HashPool(DigestAlgorithms.SHA256);
+        public static readonly HashPool Md5 = new HashPool(DigestAlgorithms.MD5);
+
+        private readonly DigestAlgorithms algorithm;
+        private readonly Func<Hash> factory;
+        private readonly Stack<Hash> pooled = new Stack<Hash>();
+        private readonly int maxPooled;
+
+        // algorithm is one of MD5, SHA1 or SHA256
+        public HashPool(DigestAlgorithms algorithm, int maxPooled = DefaultMaxPooled)
+        {
+            switch (algorithm)
+            {
+                case DigestAlgorithms.MD5:
+                    factory = Hash.md5;
+                    break;
+                case DigestAlgorithms.SHA1:
+                    factory = Hash.sha1;
+                    break;
+                case DigestAlgorithms.SHA256:
+                    factory = Hash.sha256;
+                    break;
+                default:
+                    throw new ArgumentOutOfRangeException("algorithm", algorithm, "algorithm must be MD5, SHA1 or SHA256");
+            }
+            if (maxPooled < 0)
+                throw new ArgumentOutOfRangeException("maxPooled", maxPooled, "maxPooled must not be negative");
+
+            this.algorithm = algorithm;
+            this.maxPooled = maxPooled;
+        }
+
+        public int Count
+        {
+            get
+            {
+                lock (pooled)
+                {
+                    return pooled.Count;
+                }
+            }
+        }
+
+        public Hash acquire()
+        {
+            lock (pooled)
+            {
+                if (pooled.Count > 0)
+                {
+                    Hash hash = pooled.Pop();
+                    hash.Pooled = false;
+                    return hash;
+                }
+            }
+            return factory();
+        }
+
+        // Returns a hash of this pool's algorithm for reuse, hashes beyond maxPooled are left to the GC.  The hash must
+        // not be used, or released again, until it is acquired again.
+        public void release(Hash hash)
+        {
+            if (hash == null)
+                throw new ArgumentNullException("hash");
+            if (hash.Algorithm != algorithm)
+                throw new ArgumentException(String.Format("hash is {0}, but this pool holds {1} hashes", hash.Algorithm, algorithm), "hash");
+
+            lock (pooled)
+            {
+                if (hash.Pooled)
+                    throw new ArgumentException("hash has already been released", "hash");
+                hash.Pooled = true;
+            }
+
+            hash.reset();
+            lock (pooled)
+            {
+                if (pooled.Count < maxPooled)
+                {
+                    pooled.Push(hash);
+                }
+            }
+        }
+    }
+}
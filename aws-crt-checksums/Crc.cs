@@ -3,41 +3,432 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 using System;
+using System.IO;
 using System.Runtime.InteropServices;
+using System.Text;
 
 namespace Aws.Crt.Checksums
 {
+    [Flags]
+    public enum CrcAlgorithms
+    {
+        CRC32 = 1,
+        CRC32C = 2,
+        CRC64NVME = 4,
+    }
+
+    // Result of Crc.crcFile, only the requested algorithms are set
+    public class CrcResults
+    {
+        public uint Crc32 { get; internal set; }
+        public uint Crc32c { get; internal set; }
+        public ulong Crc64nvme { get; internal set; }
+    }
+
     public class Crc
     {
         internal static class API
         {
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
-            public delegate UInt32 aws_dotnet_crc32([In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] buffer,
-                                                   Int32 length, UInt32 previous);
+            public delegate UInt32 aws_dotnet_crc32(IntPtr buffer, UInt64 length, UInt32 previous);
 
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
-            public delegate UInt32 aws_dotnet_crc32c([In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] buffer,
-                                                   Int32 length, UInt32 previous);
+            public delegate UInt32 aws_dotnet_crc32c(IntPtr buffer, UInt64 length, UInt32 previous);
             
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
-            public delegate UInt64 aws_dotnet_crc64nvme([In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2, ArraySubType = UnmanagedType.U1)] byte[] buffer,
-                                                   Int32 length, UInt64 previous);
+            public delegate UInt64 aws_dotnet_crc64nvme(IntPtr buffer, UInt64 length, UInt64 previous);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate UInt32 aws_dotnet_crc32_combine(UInt32 crc1, UInt32 crc2, UInt64 length2);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate UInt32 aws_dotnet_crc32c_combine(UInt32 crc1, UInt32 crc2, UInt64 length2);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate UInt64 aws_dotnet_crc64nvme_combine(UInt64 crc1, UInt64 crc2, UInt64 length2);
+
+            // path is NUL terminated UTF-8
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_crc_file(byte[] path, UInt64 offset, UInt64 length, UInt32 algorithms,
+                                                     [Out, MarshalAs(UnmanagedType.LPArray, SizeConst = 3)] UInt64[] results);
 
             public static aws_dotnet_crc32 crc32 = NativeAPI.Bind<aws_dotnet_crc32>();
             public static aws_dotnet_crc32c crc32c = NativeAPI.Bind<aws_dotnet_crc32c>();
             public static aws_dotnet_crc64nvme crc64nvme = NativeAPI.Bind<aws_dotnet_crc64nvme>();
+            public static aws_dotnet_crc32_combine crc32_combine = NativeAPI.Bind<aws_dotnet_crc32_combine>();
+            public static aws_dotnet_crc32c_combine crc32c_combine = NativeAPI.Bind<aws_dotnet_crc32c_combine>();
+            public static aws_dotnet_crc64nvme_combine crc64nvme_combine = NativeAPI.Bind<aws_dotnet_crc64nvme_combine>();
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_crc32_batch([In, MarshalAs(UnmanagedType.LPArray)] byte[] buffer,
+                                                        [In, MarshalAs(UnmanagedType.LPArray)] Int32[] offsets,
+                                                        [In, MarshalAs(UnmanagedType.LPArray)] Int32[] lengths,
+                                                        UInt32 count,
+                                                        [Out, MarshalAs(UnmanagedType.LPArray)] UInt32[] results);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_crc32c_batch([In, MarshalAs(UnmanagedType.LPArray)] byte[] buffer,
+                                                         [In, MarshalAs(UnmanagedType.LPArray)] Int32[] offsets,
+                                                         [In, MarshalAs(UnmanagedType.LPArray)] Int32[] lengths,
+                                                         UInt32 count,
+                                                         [Out, MarshalAs(UnmanagedType.LPArray)] UInt32[] results);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_crc64nvme_batch([In, MarshalAs(UnmanagedType.LPArray)] byte[] buffer,
+                                                            [In, MarshalAs(UnmanagedType.LPArray)] Int32[] offsets,
+                                                            [In, MarshalAs(UnmanagedType.LPArray)] Int32[] lengths,
+                                                            UInt32 count,
+                                                            [Out, MarshalAs(UnmanagedType.LPArray)] UInt64[] results);
+
+            public static aws_dotnet_crc_file crc_file = NativeAPI.Bind<aws_dotnet_crc_file>();
+            public static aws_dotnet_crc32_batch crc32_batch = NativeAPI.Bind<aws_dotnet_crc32_batch>();
+            public static aws_dotnet_crc32c_batch crc32c_batch = NativeAPI.Bind<aws_dotnet_crc32c_batch>();
+            public static aws_dotnet_crc64nvme_batch crc64nvme_batch = NativeAPI.Bind<aws_dotnet_crc64nvme_batch>();
         }
+
+        // Inputs are only split across threads in segments of at least this many bytes
+        public const long ParallelSegmentMinimumLength = 8 * 1024 * 1024;
+
+        // CRC of a segment and CRC combine, widened to 64 bits so the parallel code is shared by every algorithm
+        private delegate ulong SegmentCrc(IntPtr buffer, long length, ulong previous);
+        private delegate ulong CombineCrc(ulong crc1, ulong crc2, long length2);
+
+        private static SegmentCrc Crc32Segment = (buffer, length, previous) => API.crc32(buffer, (ulong)length, (uint)previous);
+        private static SegmentCrc Crc32cSegment = (buffer, length, previous) => API.crc32c(buffer, (ulong)length, (uint)previous);
+        private static SegmentCrc Crc64nvmeSegment = (buffer, length, previous) => API.crc64nvme(buffer, (ulong)length, previous);
+        private static CombineCrc Crc32Combine = (crc1, crc2, length2) => API.crc32_combine((uint)crc1, (uint)crc2, (ulong)length2);
+        private static CombineCrc Crc32cCombine = (crc1, crc2, length2) => API.crc32c_combine((uint)crc1, (uint)crc2, (ulong)length2);
+        private static CombineCrc Crc64nvmeCombine = (crc1, crc2, length2) => API.crc64nvme_combine(crc1, crc2, (ulong)length2);
+
+        internal static void ValidateRange(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            if (offset < 0 || offset > buffer.Length)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must be within the buffer");
+            if (count < 0 || count > buffer.Length - offset)
+                throw new ArgumentOutOfRangeException("count", count, "offset + count must be within the buffer");
+        }
+
+        // Checks that every (offsets[i], lengths[i]) record is within buffer and that results can hold them all
+        internal static void ValidateBatch(byte[] buffer, int[] offsets, int[] lengths, Array results)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            if (offsets == null)
+                throw new ArgumentNullException("offsets");
+            if (lengths == null)
+                throw new ArgumentNullException("lengths");
+            if (results == null)
+                throw new ArgumentNullException("results");
+            if (offsets.Length != lengths.Length)
+                throw new ArgumentException("offsets and lengths must have the same number of records", "lengths");
+            if (results.Length < offsets.Length)
+                throw new ArgumentException("results is too small for every record", "results");
+            for (int i = 0; i < offsets.Length; ++i)
+            {
+                ValidateRange(buffer, offsets[i], lengths[i]);
+            }
+        }
+
+        internal static void ValidateRange(IntPtr buffer, long length)
+        {
+            if (buffer == IntPtr.Zero && length != 0)
+                throw new ArgumentNullException("buffer");
+            if (length < 0)
+                throw new ArgumentOutOfRangeException("length", length, "length must not be negative");
+        }
+
         public static uint crc32(byte[] buffer, uint previous = 0)
         {
-            return API.crc32(buffer, buffer.Length, previous);
+            return crc32(buffer, 0, buffer?.Length ?? 0, previous);
+        }
+        public static uint crc32(byte[] buffer, int offset, int count, uint previous = 0)
+        {
+            ValidateRange(buffer, offset, count);
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                return API.crc32(new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (ulong)count, previous);
+            }
+            finally
+            {
+                pin.Free();
+            }
         }
+        // For native memory, or pinned memory such as a fixed Span<byte>
+        public static uint crc32(IntPtr buffer, long length, uint previous = 0)
+        {
+            ValidateRange(buffer, length);
+            return API.crc32(buffer, (ulong)length, previous);
+        }
+
         public static uint crc32c(byte[] buffer, uint previous = 0)
         {
-            return API.crc32c(buffer, buffer.Length, previous);
+            return crc32c(buffer, 0, buffer?.Length ?? 0, previous);
         }
+        public static uint crc32c(byte[] buffer, int offset, int count, uint previous = 0)
+        {
+            ValidateRange(buffer, offset, count);
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                return API.crc32c(new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (ulong)count, previous);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+        public static uint crc32c(IntPtr buffer, long length, uint previous = 0)
+        {
+            ValidateRange(buffer, length);
+            return API.crc32c(buffer, (ulong)length, previous);
+        }
+
         public static ulong crc64nvme(byte[] buffer, ulong previous = 0)
         {
-            return API.crc64nvme(buffer, buffer.Length, previous);
+            return crc64nvme(buffer, 0, buffer?.Length ?? 0, previous);
+        }
+        public static ulong crc64nvme(byte[] buffer, int offset, int count, ulong previous = 0)
+        {
+            ValidateRange(buffer, offset, count);
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                return API.crc64nvme(new IntPtr(pin.AddrOfPinnedObject().ToInt64() + offset), (ulong)count, previous);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+        public static ulong crc64nvme(IntPtr buffer, long length, ulong previous = 0)
+        {
+            ValidateRange(buffer, length);
+            return API.crc64nvme(buffer, (ulong)length, previous);
+        }
+
+        // Returns the CRC of A followed by B, given crc1 of A, crc2 of B and the length of B
+        public static uint crc32Combine(uint crc1, uint crc2, long length2)
+        {
+            return API.crc32_combine(crc1, crc2, (ulong)length2);
+        }
+        public static uint crc32cCombine(uint crc1, uint crc2, long length2)
+        {
+            return API.crc32c_combine(crc1, crc2, (ulong)length2);
+        }
+        public static ulong crc64nvmeCombine(ulong crc1, ulong crc2, long length2)
+        {
+            return API.crc64nvme_combine(crc1, crc2, (ulong)length2);
+        }
+
+        /*
+         * Batch variants checksum many small records of one buffer in a single native call: record i is
+         * [offsets[i], offsets[i] + lengths[i]) and its CRC is written to results[i].
+         */
+        public static void crc32Batch(byte[] buffer, int[] offsets, int[] lengths, uint[] results)
+        {
+            ValidateBatch(buffer, offsets, lengths, results);
+            API.crc32_batch(buffer, offsets, lengths, (uint)offsets.Length, results);
+        }
+        public static void crc32cBatch(byte[] buffer, int[] offsets, int[] lengths, uint[] results)
+        {
+            ValidateBatch(buffer, offsets, lengths, results);
+            API.crc32c_batch(buffer, offsets, lengths, (uint)offsets.Length, results);
+        }
+        public static void crc64nvmeBatch(byte[] buffer, int[] offsets, int[] lengths, ulong[] results)
+        {
+            ValidateBatch(buffer, offsets, lengths, results);
+            API.crc64nvme_batch(buffer, offsets, lengths, (uint)offsets.Length, results);
+        }
+
+        /*
+         * File variants memory map the file and checksum it in native code, without copying it through managed
+         * buffers.  length of -1 reads from offset to the end of the file.  crcFile computes several algorithms in
+         * one pass over the file.  They fail if the file has been truncated before the range is read, but on Linux
+         * and macOS a file truncated while a mapped window of it is being checksummed raises SIGBUS and kills the
+         * process, so files that other writers may shrink should be read into buffers and checksummed from those.
+         */
+        public static CrcResults crcFile(string path, CrcAlgorithms algorithms, long offset = 0, long length = -1)
+        {
+            ulong[] results = FileCrcs(path, algorithms, offset, length);
+            return new CrcResults {
+                Crc32 = (uint)results[(int)FileResult.Crc32],
+                Crc32c = (uint)results[(int)FileResult.Crc32c],
+                Crc64nvme = results[(int)FileResult.Crc64nvme],
+            };
+        }
+        public static uint crc32File(string path, long offset = 0, long length = -1)
+        {
+            return (uint)FileCrcs(path, CrcAlgorithms.CRC32, offset, length)[(int)FileResult.Crc32];
+        }
+        public static uint crc32cFile(string path, long offset = 0, long length = -1)
+        {
+            return (uint)FileCrcs(path, CrcAlgorithms.CRC32C, offset, length)[(int)FileResult.Crc32c];
+        }
+        public static ulong crc64nvmeFile(string path, long offset = 0, long length = -1)
+        {
+            return FileCrcs(path, CrcAlgorithms.CRC64NVME, offset, length)[(int)FileResult.Crc64nvme];
+        }
+
+        // Indices into the results of aws_dotnet_crc_file
+        private enum FileResult
+        {
+            Crc32,
+            Crc32c,
+            Crc64nvme,
+            Count,
+        }
+
+        private static ulong[] FileCrcs(string path, CrcAlgorithms algorithms, long offset, long length)
+        {
+            if (path == null)
+                throw new ArgumentNullException("path");
+            if (offset < 0)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must not be negative");
+            if (length < -1)
+                throw new ArgumentOutOfRangeException("length", length, "length must be -1 or not negative");
+
+            var results = new ulong[(int)FileResult.Count];
+            API.crc_file(Encoding.UTF8.GetBytes(path + "\0"), (ulong)offset, length == -1 ? UInt64.MaxValue : (ulong)length, (uint)algorithms, results);
+            return results;
+        }
+
+        /*
+         * Parallel variants split the input into one segment per thread, checksum the segments concurrently and
+         * combine the results.  threadCount defaults to the processor count; inputs too small to give every thread
+         * ParallelSegmentMinimumLength bytes use fewer threads.
+         */
+        public static uint crc32Parallel(byte[] buffer, int threadCount = 0)
+        {
+            return (uint)ParallelCrc(buffer, threadCount, Crc32Segment, Crc32Combine);
+        }
+        public static uint crc32Parallel(IntPtr buffer, long length, int threadCount = 0)
+        {
+            ValidateRange(buffer, length);
+            return (uint)ParallelCrc(buffer, length, threadCount, Crc32Segment, Crc32Combine);
+        }
+        public static uint crc32Parallel(string path, int threadCount = 0)
+        {
+            return (uint)ParallelFileCrc(path, threadCount, CrcAlgorithms.CRC32, Crc32Combine);
+        }
+
+        public static uint crc32cParallel(byte[] buffer, int threadCount = 0)
+        {
+            return (uint)ParallelCrc(buffer, threadCount, Crc32cSegment, Crc32cCombine);
+        }
+        public static uint crc32cParallel(IntPtr buffer, long length, int threadCount = 0)
+        {
+            ValidateRange(buffer, length);
+            return (uint)ParallelCrc(buffer, length, threadCount, Crc32cSegment, Crc32cCombine);
+        }
+        public static uint crc32cParallel(string path, int threadCount = 0)
+        {
+            return (uint)ParallelFileCrc(path, threadCount, CrcAlgorithms.CRC32C, Crc32cCombine);
+        }
+
+        public static ulong crc64nvmeParallel(byte[] buffer, int threadCount = 0)
+        {
+            return ParallelCrc(buffer, threadCount, Crc64nvmeSegment, Crc64nvmeCombine);
+        }
+        public static ulong crc64nvmeParallel(IntPtr buffer, long length, int threadCount = 0)
+        {
+            ValidateRange(buffer, length);
+            return ParallelCrc(buffer, length, threadCount, Crc64nvmeSegment, Crc64nvmeCombine);
+        }
+        public static ulong crc64nvmeParallel(string path, int threadCount = 0)
+        {
+            return ParallelFileCrc(path, threadCount, CrcAlgorithms.CRC64NVME, Crc64nvmeCombine);
+        }
+
+        private static int SegmentCount(long length, int threadCount)
+        {
+            if (threadCount <= 0)
+            {
+                threadCount = Environment.ProcessorCount;
+            }
+            long segments = Math.Min(threadCount, length / ParallelSegmentMinimumLength);
+            return (int)Math.Max(1, segments);
+        }
+
+        // Runs segmentCrc(i) for every segment, all but the first on new threads, and rethrows the first failure
+        private static ulong[] RunSegments(int segments, Func<int, ulong> segmentCrc)
+        {
+            var results = new ulong[segments];
+            ParallelParts.Run(segments, (segment) => results[segment] = segmentCrc(segment));
+            return results;
+        }
+
+        private static ulong CombineSegments(ulong[] results, long length, long segmentLength, CombineCrc combine)
+        {
+            ulong crc = results[0];
+            for (int i = 1; i < results.Length; ++i)
+            {
+                long segmentStart = i * segmentLength;
+                crc = combine(crc, results[i], Math.Min(segmentLength, length - segmentStart));
+            }
+            return crc;
+        }
+
+        private static ulong ParallelCrc(byte[] buffer, int threadCount, SegmentCrc crc, CombineCrc combine)
+        {
+            ValidateRange(buffer, 0, buffer?.Length ?? 0);
+            GCHandle pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try
+            {
+                return ParallelCrc(pin.AddrOfPinnedObject(), buffer.Length, threadCount, crc, combine);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        private static ulong ParallelCrc(IntPtr buffer, long length, int threadCount, SegmentCrc crc, CombineCrc combine)
+        {
+            int segments = SegmentCount(length, threadCount);
+            if (segments == 1)
+            {
+                return crc(buffer, length, 0);
+            }
+
+            long segmentLength = (length + segments - 1) / segments;
+            ulong[] results = RunSegments(segments, (segment) => {
+                long segmentStart = segment * segmentLength;
+                long segmentEnd = Math.Min(length, segmentStart + segmentLength);
+                return crc(new IntPtr(buffer.ToInt64() + segmentStart), segmentEnd - segmentStart, 0);
+            });
+            return CombineSegments(results, length, segmentLength, combine);
+        }
+
+        private static ulong ParallelFileCrc(string path, int threadCount, CrcAlgorithms algorithm, CombineCrc combine)
+        {
+            if (path == null)
+                throw new ArgumentNullException("path");
+
+            long length = new FileInfo(path).Length;
+            int segments = SegmentCount(length, threadCount);
+            long segmentLength = Math.Max(1, (length + segments - 1) / segments);
+            ulong[] results = RunSegments(segments, (segment) => {
+                long segmentStart = segment * segmentLength;
+                long remaining = Math.Min(length, segmentStart + segmentLength) - segmentStart;
+                return FileSegmentCrc(path, segmentStart, remaining, algorithm);
+            });
+            return CombineSegments(results, length, segmentLength, combine);
+        }
+
+        private static ulong FileSegmentCrc(string path, long offset, long length, CrcAlgorithms algorithm)
+        {
+            ulong[] results = FileCrcs(path, algorithm, offset, length);
+            switch (algorithm)
+            {
+                case CrcAlgorithms.CRC32:
+                    return results[(int)FileResult.Crc32];
+                case CrcAlgorithms.CRC32C:
+                    return results[(int)FileResult.Crc32c];
+                default:
+                    return results[(int)FileResult.Crc64nvme];
+            }
         }
     }
 }
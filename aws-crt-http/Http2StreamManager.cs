@@ -0,0 +1,183 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+using System.Net;
+using System.Runtime.InteropServices;
+using System.Security;
+
+using Aws.Crt;
+using Aws.Crt.IO;
+
+namespace Aws.Crt.Http
+{
+    public sealed class Http2StreamManagerOptions
+    {
+        public ClientBootstrap Bootstrap;
+        public String Host;
+        public UInt16 Port;
+        public SocketOptions SocketOptions;
+
+        // HTTP/2 is negotiated over TLS with ALPN, so the TLS context must list "h2" in TlsContextOptions.AlpnList
+        public TlsConnectionOptions TlsConnectionOptions;
+
+        // Plaintext HTTP/2 (h2c) without an upgrade, for servers known to support it; ignored with TLS
+        public bool Http2PriorKnowledge;
+
+        public Int32 MaxConnections;
+
+        // Streams are spread so that each connection carries this many before another connection is opened, 0 for
+        // the native default
+        public Int32 IdealConcurrentStreamsPerConnection;
+
+        // A connection never carries more streams than this, or than the server allows, 0 for no limit of our own
+        public Int32 MaxConcurrentStreamsPerConnection;
+
+        // Response body each stream may receive before its flow-control window must be opened with UpdateWindow.
+        // Ignored unless ManualWindowManagement is set, in which case each stream's window starts at this size.
+        public UInt64 InitialWindowSize;
+        public bool ManualWindowManagement;
+
+        internal void Validate()
+        {
+            if (Bootstrap == null)
+                throw new ArgumentNullException("Bootstrap");
+            if (Host == null)
+                throw new ArgumentNullException("Host");
+            if (MaxConnections <= 0)
+                throw new ArgumentOutOfRangeException("MaxConnections", MaxConnections, "MaxConnections must be positive");
+            if (IdealConcurrentStreamsPerConnection < 0)
+                throw new ArgumentOutOfRangeException("IdealConcurrentStreamsPerConnection", IdealConcurrentStreamsPerConnection, "IdealConcurrentStreamsPerConnection must not be negative");
+            if (MaxConcurrentStreamsPerConnection < 0)
+                throw new ArgumentOutOfRangeException("MaxConcurrentStreamsPerConnection", MaxConcurrentStreamsPerConnection, "MaxConcurrentStreamsPerConnection must not be negative");
+            if (TlsConnectionOptions == null && !Http2PriorKnowledge)
+                throw new ArgumentException("HTTP/2 needs TlsConnectionOptions, negotiated with ALPN, or Http2PriorKnowledge");
+        }
+    }
+
+    /*
+     * Multiplexes requests as HTTP/2 streams over a few connections to one endpoint.  Connections are opened as the
+     * streams in flight need them, up to MaxConnections, and each request completes independently of the others
+     * sharing its connection.
+     */
+    public sealed class Http2StreamManager
+    {
+        [SecuritySafeCritical]
+        internal static class API
+        {
+            static private LibraryHandle library = new LibraryHandle();
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate Handle aws_dotnet_http2_stream_manager_new(
+                                    IntPtr clientBootstrap,
+                                    [MarshalAs(UnmanagedType.LPStr)] string hostName,
+                                    UInt16 port,
+                                    IntPtr socketOptions,
+                                    IntPtr tlsConnectionOptions,
+                                    [MarshalAs(UnmanagedType.U1)] bool http2PriorKnowledge,
+                                    Int32 maxConnections,
+                                    Int32 idealConcurrentStreamsPerConnection,
+                                    Int32 maxConcurrentStreamsPerConnection,
+                                    UInt64 initialWindowSize,
+                                    [MarshalAs(UnmanagedType.U1)] bool manualWindowManagement);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_http2_stream_manager_destroy(IntPtr manager);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate HttpStream.Handle aws_dotnet_http2_stream_manager_make_request(
+                                    IntPtr manager,
+                                    [MarshalAs(UnmanagedType.LPStr)] string method,
+                                    [MarshalAs(UnmanagedType.LPStr)] string uri,
+                                    [In] HttpHeaderNative[] headers,
+                                    UInt32 header_count,
+                                    [In] CrtStreamWrapper.DelegateTable streamDelegateTable,
+                                    HttpStream.API.OnIncomingHeadersNative onIncomingHeaders,
+                                    HttpStream.API.OnIncomingHeaderBlockDoneNative onIncomingHeaderBlockDone,
+                                    HttpStream.API.OnIncomingBodyNative onIncomingBody,
+                                    HttpStream.API.OnStreamCompleteNative onStreamComplete);
+
+            public static aws_dotnet_http2_stream_manager_new make_new = NativeAPI.Bind<aws_dotnet_http2_stream_manager_new>();
+            public static aws_dotnet_http2_stream_manager_destroy destroy = NativeAPI.Bind<aws_dotnet_http2_stream_manager_destroy>();
+            internal static aws_dotnet_http2_stream_manager_make_request make_request = NativeAPI.Bind<aws_dotnet_http2_stream_manager_make_request>();
+        }
+
+        public class Handle : CRT.Handle
+        {
+            protected override bool ReleaseHandle()
+            {
+                API.destroy(handle);
+                return true;
+            }
+        }
+
+        internal Handle NativeHandle { get; private set; }
+
+        // Streams in flight, kept from being GC'ed until they complete
+        private HashSet<HttpClientStream> streams = new HashSet<HttpClientStream>();
+
+        public Http2StreamManager(Http2StreamManagerOptions options)
+        {
+            options.Validate();
+
+            NativeHandle = API.make_new(
+                options.Bootstrap.NativeHandle.DangerousGetHandle(),
+                options.Host,
+                options.Port,
+                options.SocketOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
+                options.TlsConnectionOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
+                options.Http2PriorKnowledge,
+                options.MaxConnections,
+                options.IdealConcurrentStreamsPerConnection,
+                options.MaxConcurrentStreamsPerConnection,
+                options.InitialWindowSize,
+                options.ManualWindowManagement);
+        }
+
+        private class StreamBootstrap
+        {
+            public CrtResult<StreamResult> Result = new CrtResult<StreamResult>();
+            public HttpClientStream Stream;
+            public bool Completed;
+        }
+
+        /*
+         * Queues request to be sent on a stream of whichever connection has room, opening one if needed.  The result
+         * fails if no connection could be had, as well as if the stream itself fails.  The stream has no Connection.
+         */
+        public CrtResult<StreamResult> MakeRequest(HttpRequest request, HttpResponseStreamHandler responseHandler)
+        {
+            var bootstrap = new StreamBootstrap();
+            responseHandler.StreamComplete += (sender, e) => {
+                lock (streams)
+                {
+                    // Failing to get a connection can complete the stream before it has been added
+                    bootstrap.Completed = true;
+                    streams.Remove((HttpClientStream)sender);
+                }
+                if (e.ErrorCode != 0)
+                {
+                    var message = CRT.ErrorString(e.ErrorCode);
+                    bootstrap.Result.CompleteExceptionally(new WebException($"Stream {sender} failed: {message}"));
+                }
+                else
+                {
+                    bootstrap.Result.Complete(new StreamResult(e.ErrorCode));
+                }
+            };
+
+            bootstrap.Stream = new HttpClientStream(this, request, responseHandler);
+            lock (streams)
+            {
+                if (!bootstrap.Completed)
+                {
+                    streams.Add(bootstrap.Stream);
+                }
+            }
+
+            return bootstrap.Result;
+        }
+    }
+}
@@ -15,9 +15,11 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Net;
 using System.Runtime.InteropServices;
 using System.Security;
+using System.Threading;
 
 using Aws.Crt;
 using Aws.Crt.IO;
@@ -33,14 +35,60 @@ namespace Aws.Crt.Http
         public UInt64 InitialWindowSize;
         public SocketOptions SocketOptions;
         public TlsConnectionOptions TlsConnectionOptions;
+
+        // Idle connections kept open beyond those currently leased, ready for a burst: opened when the manager is
+        // created, and topped up periodically as they are leased or close.  Warm connections count toward
+        // MaxConnections, so fewer are kept once leases approach it.
+        public UInt32 MinWarmConnections;
+
+        // Idle connections unused for this long are closed, 0 to keep them until the server closes them.  Warm
+        // connections are closed too, and reopened at the next top up.
+        public UInt64 MaxConnectionIdleTimeMs;
+
+        // Stop reading a response body once InitialWindowSize bytes of it are unread, until the window is opened with
+        // HttpStream.UpdateWindow, e.g. by an HttpResponseBodyReader
+        public bool ManualWindowManagement;
         // TODO: Proxy support
     }
 
+    /* A snapshot of a connection manager's pool, plus counters accumulated since the manager was created */
+    public sealed class HttpClientConnectionManagerMetrics
+    {
+        // Upper bounds, in milliseconds, of the acquire wait time buckets; AcquireWaitCounts has one more bucket, for
+        // longer waits
+        public static readonly double[] AcquireWaitBucketBoundsMs = { 1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000 };
+
+        // Idle connections in the pool
+        public ulong AvailableConnections { get; internal set; }
+        // Connections currently acquired and not yet released
+        public ulong LeasedConnections { get; internal set; }
+        // Acquisitions waiting for a connection
+        public ulong PendingAcquisitions { get; internal set; }
+
+        public long Acquisitions { get; internal set; }
+        public long FailedAcquisitions { get; internal set; }
+
+        // Time from AcquireConnection to completion, for successful and failed acquisitions alike
+        public long[] AcquireWaitCounts { get; internal set; }
+        public TimeSpan TotalAcquireWait { get; internal set; }
+        public TimeSpan MaxAcquireWait { get; internal set; }
+    }
+
     public sealed class HttpClientConnectionManager
     {
         [SecuritySafeCritical]
         internal static class API
         {
+            internal delegate void OnConnectionAcquired(UInt64 callbackId, int errorCode, IntPtr connection);
+
+            [StructLayout(LayoutKind.Sequential)]
+            internal struct NativeMetrics
+            {
+                public UInt64 AvailableConnections;
+                public UInt64 LeasedConnections;
+                public UInt64 PendingAcquisitions;
+            }
+
             static private LibraryHandle library = new LibraryHandle();
             public delegate Handle aws_dotnet_http_client_connection_manager_new(
                                     IntPtr clientBootstrap,
@@ -49,13 +97,44 @@ namespace Aws.Crt.Http
                                     IntPtr socketOptions,
                                     IntPtr tlsConnectionOptions,
                                     Int32  maxConnections,
-                                    UInt64 initialWindowSize);
+                                    UInt64 initialWindowSize,
+                                    UInt64 maxConnectionIdleTimeMs,
+                                    [MarshalAs(UnmanagedType.U1)] bool manualWindowManagement);
             public delegate void aws_dotnet_http_client_connection_manager_destroy(IntPtr manager);
 
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void aws_dotnet_http_client_connection_manager_acquire_connection(
+                                    IntPtr manager,
+                                    UInt64 callbackId,
+                                    OnConnectionAcquired onAcquired);
+
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate void aws_dotnet_http_client_connection_manager_fetch_metrics(
+                                    IntPtr manager,
+                                    out NativeMetrics metrics);
+
             public static aws_dotnet_http_client_connection_manager_new make_new = NativeAPI.Bind<aws_dotnet_http_client_connection_manager_new>();
             public static aws_dotnet_http_client_connection_manager_destroy destroy = NativeAPI.Bind<aws_dotnet_http_client_connection_manager_destroy>();
+            internal static aws_dotnet_http_client_connection_manager_acquire_connection acquire_connection = NativeAPI.Bind<aws_dotnet_http_client_connection_manager_acquire_connection>();
+            internal static aws_dotnet_http_client_connection_manager_fetch_metrics fetch_metrics = NativeAPI.Bind<aws_dotnet_http_client_connection_manager_fetch_metrics>();
+
+            // Static, so it stays alive for acquisitions that outlive their manager
+            internal static OnConnectionAcquired on_connection_acquired = HttpClientConnectionManager.OnConnectionAcquired;
         }
 
+        private class Acquisition
+        {
+            public CrtResult<HttpClientConnection> Result = new CrtResult<HttpClientConnection>();
+            public HttpClientConnectionManager Manager;
+            public long StartTimestamp = Stopwatch.GetTimestamp();
+            public bool RecordMetrics = true;
+        }
+
+        // How often warm connections are topped up when idle connections are never culled
+        private const int WarmCheckIntervalMs = 10000;
+
+        private static StrongReferenceVendor<Acquisition> PendingAcquisitions = new StrongReferenceVendor<Acquisition>();
+
         public class Handle : CRT.Handle
         {
             protected override bool ReleaseHandle()
@@ -68,17 +147,214 @@ namespace Aws.Crt.Http
         internal Handle NativeHandle { get; private set; }
         private HttpClientConnectionManagerOptions options;
 
+        // Acquisition counters, guarded by the array itself
+        private long[] acquireWaitCounts = new long[HttpClientConnectionManagerMetrics.AcquireWaitBucketBoundsMs.Length + 1];
+        private long acquisitions;
+        private long failedAcquisitions;
+        private long totalAcquireWaitTicks;
+        private long maxAcquireWaitTicks;
+
+        // Holds the manager weakly, so an unreferenced manager is still collected
+        private Timer warmTimer;
+        private int warming;
+
         public HttpClientConnectionManager(HttpClientConnectionManagerOptions options) {
+            if (options.Bootstrap == null)
+                throw new ArgumentNullException("Bootstrap");
+            if (options.Host == null)
+                throw new ArgumentNullException("Host");
+
             this.options = options;
             NativeHandle = API.make_new(
                 options.Bootstrap.NativeHandle.DangerousGetHandle(), 
                 options.Host, options.Port, 
-                options.SocketOptions.NativeHandle.DangerousGetHandle(), 
-                options.TlsConnectionOptions.NativeHandle.DangerousGetHandle(), 
-                options.MaxConnections, options.InitialWindowSize);
+                options.SocketOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
+                options.TlsConnectionOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
+                options.MaxConnections, options.InitialWindowSize, options.MaxConnectionIdleTimeMs,
+                options.ManualWindowManagement);
+
+            if (options.MinWarmConnections > 0)
+            {
+                // Check twice per idle period, so culled warm connections are soon reopened
+                long period = options.MaxConnectionIdleTimeMs > 0
+                    ? (long)Math.Min((ulong)WarmCheckIntervalMs, Math.Max(options.MaxConnectionIdleTimeMs / 2, 1))
+                    : WarmCheckIntervalMs;
+                warmTimer = new Timer(OnWarmTimer, new WeakReference(this), 0, period);
+            }
+        }
+
+        private static void OnWarmTimer(object state)
+        {
+            var manager = (HttpClientConnectionManager)((WeakReference)state).Target;
+            if (manager != null)
+            {
+                manager.WarmConnections();
+            }
+        }
+
+        ~HttpClientConnectionManager()
+        {
+            if (warmTimer != null)
+            {
+                warmTimer.Dispose();
+            }
+        }
+
+        /*
+         * Opens connections until MinWarmConnections are idle, then releases them to the pool.  The pool only opens a
+         * connection for an acquisition once its idle connections are all leased, so the idle connections are held
+         * alongside the new ones while they open.  Nothing is leased while enough connections are idle.
+         */
+        private void WarmConnections()
+        {
+            API.NativeMetrics metrics = FetchNativeMetrics();
+            long idle = (long)metrics.AvailableConnections;
+            long shortfall = Math.Min(
+                (long)options.MinWarmConnections - idle,
+                (long)options.MaxConnections - (long)metrics.LeasedConnections - idle);
+            if (shortfall <= 0 || Interlocked.Exchange(ref warming, 1) != 0)
+            {
+                return;
+            }
+
+            long needed = idle + shortfall;
 
+            var warmed = new List<HttpClientConnection>();
+            int outstanding = (int)needed;
+            Action onDone = () => {
+                if (Interlocked.Decrement(ref outstanding) > 0)
+                {
+                    return;
+                }
+                foreach (var connection in warmed)
+                {
+                    connection.Release();
+                }
+                Interlocked.Exchange(ref warming, 0);
+            };
+
+            for (long i = 0; i < needed; ++i)
+            {
+                var result = AcquireConnection(false);
+                result.CompletionCallback = (connection) => {
+                    lock (warmed)
+                    {
+                        warmed.Add(connection);
+                    }
+                    onDone();
+                };
+                result.ExceptionCallback = (exception) => onDone();
+            }
+        }
+
+        /*
+         * Leases a connection, reusing an idle keep-alive connection if there is one, and opening a new one if the pool
+         * is below MaxConnections.  Otherwise the result completes once another lease is released.  Every connection
+         * acquired must be handed back with ReleaseConnection once its streams have completed.
+         */
+        public CrtResult<HttpClientConnection> AcquireConnection()
+        {
+            return AcquireConnection(true);
+        }
+
+        private CrtResult<HttpClientConnection> AcquireConnection(bool recordMetrics)
+        {
+            var acquisition = new Acquisition();
+            acquisition.Manager = this; /* keeps the manager alive while the acquisition is pending */
+            acquisition.RecordMetrics = recordMetrics;
+
+            ulong id = PendingAcquisitions.AcquireStrongReference(acquisition);
+            API.acquire_connection(NativeHandle.DangerousGetHandle(), id, API.on_connection_acquired);
+
+            return acquisition.Result;
         }
 
+        // Returns a connection from AcquireConnection to the pool, after which it must not be used
+        public void ReleaseConnection(HttpClientConnection connection)
+        {
+            if (connection == null)
+                throw new ArgumentNullException("connection");
+            if (connection.Manager != this)
+                throw new ArgumentException("connection was not acquired from this manager", "connection");
+
+            connection.Release();
+        }
+
+        // Samples the pool and copies the counters; cheap enough to poll
+        public HttpClientConnectionManagerMetrics FetchMetrics()
+        {
+            API.NativeMetrics nativeMetrics = FetchNativeMetrics();
+
+            var metrics = new HttpClientConnectionManagerMetrics();
+            metrics.AvailableConnections = nativeMetrics.AvailableConnections;
+            metrics.LeasedConnections = nativeMetrics.LeasedConnections;
+            metrics.PendingAcquisitions = nativeMetrics.PendingAcquisitions;
 
+            lock (acquireWaitCounts)
+            {
+                metrics.Acquisitions = acquisitions;
+                metrics.FailedAcquisitions = failedAcquisitions;
+                metrics.AcquireWaitCounts = (long[])acquireWaitCounts.Clone();
+                metrics.TotalAcquireWait = TimeSpan.FromSeconds((double)totalAcquireWaitTicks / Stopwatch.Frequency);
+                metrics.MaxAcquireWait = TimeSpan.FromSeconds((double)maxAcquireWaitTicks / Stopwatch.Frequency);
+            }
+            return metrics;
+        }
+
+        internal API.NativeMetrics FetchNativeMetrics()
+        {
+            API.NativeMetrics metrics;
+            API.fetch_metrics(NativeHandle.DangerousGetHandle(), out metrics);
+            return metrics;
+        }
+
+        private void RecordAcquisition(bool succeeded, long waitTicks)
+        {
+            double waitMs = waitTicks * 1000.0 / Stopwatch.Frequency;
+            var bounds = HttpClientConnectionManagerMetrics.AcquireWaitBucketBoundsMs;
+            int bucket = 0;
+            while (bucket < bounds.Length && waitMs > bounds[bucket])
+            {
+                ++bucket;
+            }
+
+            lock (acquireWaitCounts)
+            {
+                if (succeeded)
+                {
+                    ++acquisitions;
+                }
+                else
+                {
+                    ++failedAcquisitions;
+                }
+                ++acquireWaitCounts[bucket];
+                totalAcquireWaitTicks += waitTicks;
+                maxAcquireWaitTicks = Math.Max(maxAcquireWaitTicks, waitTicks);
+            }
+        }
+
+        private static void OnConnectionAcquired(ulong id, int errorCode, IntPtr connection)
+        {
+            Acquisition acquisition = PendingAcquisitions.ReleaseStrongReference(id);
+            if (acquisition == null) {
+                return;
+            }
+
+            if (acquisition.RecordMetrics)
+            {
+                acquisition.Manager.RecordAcquisition(errorCode == 0, Stopwatch.GetTimestamp() - acquisition.StartTimestamp);
+            }
+
+            if (errorCode != 0)
+            {
+                var message = CRT.ErrorString(errorCode);
+                acquisition.Result.CompleteExceptionally(new WebException(String.Format("Failed to acquire connection: {0}", message)));
+            }
+            else
+            {
+                acquisition.Result.Complete(new HttpClientConnection(connection, acquisition.Manager));
+            }
+        }
     }
 }
@@ -0,0 +1,368 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+
+using Aws.Crt;
+using Aws.Crt.IO;
+
+namespace Aws.Crt.Http
+{
+    public sealed class HttpClientConnectionPoolOptions
+    {
+        public const Int32 DefaultMaxIdleEndpoints = 16;
+
+        public ClientBootstrap Bootstrap;
+        public SocketOptions SocketOptions;
+        public UInt64 InitialWindowSize;
+
+        // Connections open at once across every endpoint, leased or idle
+        public Int32 MaxConnections;
+        public Int32 MaxConnectionsPerEndpoint;
+
+        // Endpoints with no leased connections beyond this many are evicted, least recently used first, when another
+        // endpoint is first used.  0 evicts every idle endpoint then.
+        public Int32 MaxIdleEndpoints = DefaultMaxIdleEndpoints;
+
+        // Passed to each endpoint's HttpClientConnectionManager
+        public UInt64 MaxConnectionIdleTimeMs;
+        public bool ManualWindowManagement;
+    }
+
+    /*
+     * Keep-alive connection pools for any number of endpoints, each an HttpClientConnectionManager created on first
+     * use and keyed by host, port and TLS options.  The pools share one bootstrap and one cap on open connections.  When
+     * the cap is reached, endpoints with no leased connections are evicted, least recently used first, closing their
+     * idle connections; acquisitions that still do not fit wait, in order, for a release.
+     *
+     * Open connections are counted as they are acquired, released and evicted.  Idle connections can also close on
+     * their own, so when the cap appears to be reached the idle counts are refreshed from the pools' metrics before an
+     * acquisition is made to wait.  The cap can be briefly exceeded while an evicted pool's connections close.
+     *
+     * A leased connection that is collected without being released goes back to its manager when it is finalized.
+     * Leases are held weakly, so those connections are counted as idle again at the same points, once collected.
+     */
+    public sealed class HttpClientConnectionPool
+    {
+        private struct EndpointKey : IEquatable<EndpointKey>
+        {
+            public string Host;
+            public UInt16 Port;
+            public TlsConnectionOptions TlsConnectionOptions;
+
+            public bool Equals(EndpointKey other)
+            {
+                return Port == other.Port
+                    && ReferenceEquals(TlsConnectionOptions, other.TlsConnectionOptions)
+                    && String.Equals(Host, other.Host, StringComparison.OrdinalIgnoreCase);
+            }
+
+            public override bool Equals(object obj)
+            {
+                return obj is EndpointKey && Equals((EndpointKey)obj);
+            }
+
+            public override int GetHashCode()
+            {
+                int hash = StringComparer.OrdinalIgnoreCase.GetHashCode(Host) * 31 + Port;
+                return TlsConnectionOptions == null ? hash : hash * 31 + TlsConnectionOptions.GetHashCode();
+            }
+        }
+
+        private class Endpoint
+        {
+            public EndpointKey Key;
+            public HttpClientConnectionManager Manager;
+            public LinkedListNode<Endpoint> LruNode;
+
+            // Connections leased from this endpoint plus acquisitions admitted or waiting for it
+            public int Leases;
+            // The connections leased, held weakly to notice those collected without being released
+            public List<WeakReference> Leased = new List<WeakReference>();
+            // Connections released and not since reacquired, some of which may have closed
+            public int Idle;
+        }
+
+        private class PendingAcquisition
+        {
+            public Endpoint Endpoint;
+            public CrtResult<HttpClientConnection> Result = new CrtResult<HttpClientConnection>();
+            // Admitted to reuse one of the endpoint's idle connections, rather than to open one
+            public bool ReusesIdle;
+        }
+
+        private HttpClientConnectionPoolOptions options;
+
+        // All guarded by endpoints
+        private Dictionary<EndpointKey, Endpoint> endpoints = new Dictionary<EndpointKey, Endpoint>();
+        private Dictionary<HttpClientConnectionManager, Endpoint> endpointsByManager = new Dictionary<HttpClientConnectionManager, Endpoint>();
+        // Most recently used first
+        private LinkedList<Endpoint> lru = new LinkedList<Endpoint>();
+        private Queue<PendingAcquisition> waiting = new Queue<PendingAcquisition>();
+        // Connections leased, idle or being acquired across every endpoint
+        private int openConnections;
+
+        public HttpClientConnectionPool(HttpClientConnectionPoolOptions options)
+        {
+            if (options.Bootstrap == null)
+                throw new ArgumentNullException("Bootstrap");
+            if (options.MaxConnections <= 0)
+                throw new ArgumentOutOfRangeException("MaxConnections", options.MaxConnections, "MaxConnections must be positive");
+            if (options.MaxConnectionsPerEndpoint <= 0)
+                throw new ArgumentOutOfRangeException("MaxConnectionsPerEndpoint", options.MaxConnectionsPerEndpoint, "MaxConnectionsPerEndpoint must be positive");
+            if (options.MaxIdleEndpoints < 0)
+                throw new ArgumentOutOfRangeException("MaxIdleEndpoints", options.MaxIdleEndpoints, "MaxIdleEndpoints must not be negative");
+
+            this.options = options;
+        }
+
+        public int EndpointCount
+        {
+            get
+            {
+                lock (endpoints)
+                {
+                    return endpoints.Count;
+                }
+            }
+        }
+
+        // Leases a connection to host:port, over TLS if tlsConnectionOptions is set
+        public CrtResult<HttpClientConnection> AcquireConnection(string host, UInt16 port, TlsConnectionOptions tlsConnectionOptions = null)
+        {
+            if (host == null)
+                throw new ArgumentNullException("host");
+
+            var key = new EndpointKey { Host = host, Port = port, TlsConnectionOptions = tlsConnectionOptions };
+            var pending = new PendingAcquisition();
+            bool admitted;
+            lock (endpoints)
+            {
+                pending.Endpoint = GetEndpoint(key);
+                pending.Endpoint.Leases++;
+                lru.Remove(pending.Endpoint.LruNode);
+                lru.AddFirst(pending.Endpoint.LruNode);
+
+                admitted = waiting.Count == 0 && TryAdmit(pending);
+                if (!admitted)
+                {
+                    waiting.Enqueue(pending);
+                }
+            }
+
+            if (admitted)
+            {
+                Start(pending);
+            }
+            return pending.Result;
+        }
+
+        // Returns a connection from AcquireConnection to its endpoint's pool, after which it must not be used
+        public void ReleaseConnection(HttpClientConnection connection)
+        {
+            if (connection == null)
+                throw new ArgumentNullException("connection");
+
+            Endpoint endpoint;
+            lock (endpoints)
+            {
+                if (connection.Manager == null || !endpointsByManager.TryGetValue(connection.Manager, out endpoint))
+                    throw new ArgumentException("connection was not acquired from this pool", "connection");
+
+                int index = endpoint.Leased.FindIndex(lease => lease.Target == connection);
+                if (index < 0)
+                    throw new ArgumentException("connection has already been released", "connection");
+                endpoint.Leased.RemoveAt(index);
+            }
+
+            // Outside the lock, since it calls into native code.  The lease is still counted, so the endpoint can't be
+            // evicted in the meantime.
+            endpoint.Manager.ReleaseConnection(connection);
+
+            lock (endpoints)
+            {
+                endpoint.Leases--;
+                endpoint.Idle++;
+            }
+
+            AdmitWaiting();
+        }
+
+        // Must be called under the lock
+        private Endpoint GetEndpoint(EndpointKey key)
+        {
+            Endpoint endpoint;
+            if (endpoints.TryGetValue(key, out endpoint))
+            {
+                return endpoint;
+            }
+
+            var managerOptions = new HttpClientConnectionManagerOptions();
+            managerOptions.Bootstrap = options.Bootstrap;
+            managerOptions.Host = key.Host;
+            managerOptions.Port = key.Port;
+            managerOptions.MaxConnections = options.MaxConnectionsPerEndpoint;
+            managerOptions.InitialWindowSize = options.InitialWindowSize;
+            managerOptions.SocketOptions = options.SocketOptions;
+            managerOptions.TlsConnectionOptions = key.TlsConnectionOptions;
+            managerOptions.MaxConnectionIdleTimeMs = options.MaxConnectionIdleTimeMs;
+            managerOptions.ManualWindowManagement = options.ManualWindowManagement;
+
+            endpoint = new Endpoint();
+            endpoint.Key = key;
+            endpoint.Manager = new HttpClientConnectionManager(managerOptions);
+            endpoint.LruNode = new LinkedListNode<Endpoint>(endpoint);
+
+            endpoints.Add(key, endpoint);
+            endpointsByManager.Add(endpoint.Manager, endpoint);
+            lru.AddFirst(endpoint.LruNode);
+
+            if (IdleEndpointCount() > options.MaxIdleEndpoints)
+            {
+                ReclaimCollectedLeases();
+                EvictIdleEndpoints(endpoint, () => IdleEndpointCount() > options.MaxIdleEndpoints);
+            }
+            return endpoint;
+        }
+
+        // Must be called under the lock.  An idle connection at the endpoint is reused, anything else needs room.
+        private bool TryAdmit(PendingAcquisition pending)
+        {
+            var endpoint = pending.Endpoint;
+            if (endpoint.Idle == 0 && openConnections >= options.MaxConnections)
+            {
+                ReclaimCollectedLeases();
+                EvictIdleEndpoints(endpoint, () => openConnections >= options.MaxConnections);
+                if (openConnections >= options.MaxConnections)
+                {
+                    ForgetClosedIdleConnections();
+                }
+                if (endpoint.Idle == 0 && openConnections >= options.MaxConnections)
+                {
+                    return false;
+                }
+            }
+
+            if (endpoint.Idle > 0)
+            {
+                endpoint.Idle--;
+                pending.ReusesIdle = true;
+            }
+            else
+            {
+                openConnections++;
+            }
+            return true;
+        }
+
+        // Must be called under the lock.  Idle connections only ever close on their own, so the counts are lowered to
+        // what each pool still has, without counting again connections already handed to an admitted acquisition.
+        private void ForgetClosedIdleConnections()
+        {
+            foreach (var endpoint in lru)
+            {
+                int available = (int)Math.Min(endpoint.Manager.FetchNativeMetrics().AvailableConnections, (ulong)int.MaxValue);
+                if (available < endpoint.Idle)
+                {
+                    openConnections -= endpoint.Idle - available;
+                    endpoint.Idle = available;
+                }
+            }
+        }
+
+        // Must be called under the lock.  A leased connection collected without being released has been, or is about to
+        // be, released to its manager by its finalizer, so it counts as idle from now on.
+        private void ReclaimCollectedLeases()
+        {
+            foreach (var endpoint in lru)
+            {
+                int collected = endpoint.Leased.RemoveAll(lease => !lease.IsAlive);
+                endpoint.Leases -= collected;
+                endpoint.Idle += collected;
+            }
+        }
+
+        private int IdleEndpointCount()
+        {
+            int idle = 0;
+            foreach (var endpoint in lru)
+            {
+                if (endpoint.Leases == 0)
+                {
+                    idle++;
+                }
+            }
+            return idle;
+        }
+
+        // Evicts endpoints with no leases, least recently used first and never keep, while shouldEvict holds
+        private void EvictIdleEndpoints(Endpoint keep, Func<bool> shouldEvict)
+        {
+            var node = lru.Last;
+            while (node != null && shouldEvict())
+            {
+                var previous = node.Previous;
+                var endpoint = node.Value;
+                if (endpoint != keep && endpoint.Leases == 0)
+                {
+                    // With no leases, all of its open connections are idle
+                    openConnections -= endpoint.Idle;
+                    lru.Remove(node);
+                    endpoints.Remove(endpoint.Key);
+                    endpointsByManager.Remove(endpoint.Manager);
+                    // Closes the idle connections now rather than when the manager is collected
+                    endpoint.Manager.NativeHandle.Dispose();
+                }
+                node = previous;
+            }
+        }
+
+        private void Start(PendingAcquisition pending)
+        {
+            var result = pending.Endpoint.Manager.AcquireConnection();
+            result.CompletionCallback = (connection) => {
+                lock (endpoints)
+                {
+                    pending.Endpoint.Leased.Add(new WeakReference(connection));
+                }
+                pending.Result.Complete(connection);
+            };
+            result.ExceptionCallback = (exception) => {
+                lock (endpoints)
+                {
+                    pending.Endpoint.Leases--;
+                    if (pending.ReusesIdle)
+                    {
+                        pending.Endpoint.Idle++;
+                    }
+                    else
+                    {
+                        openConnections--;
+                    }
+                }
+                pending.Result.CompleteExceptionally(exception);
+                AdmitWaiting();
+            };
+        }
+
+        // Starts waiting acquisitions, in order, for as long as they fit
+        private void AdmitWaiting()
+        {
+            var admitted = new List<PendingAcquisition>();
+            lock (endpoints)
+            {
+                while (waiting.Count > 0 && TryAdmit(waiting.Peek()))
+                {
+                    admitted.Add(waiting.Dequeue());
+                }
+            }
+
+            foreach (var pending in admitted)
+            {
+                Start(pending);
+            }
+        }
+    }
+}
@@ -42,13 +42,29 @@ namespace Aws.Crt.Http
 
     public class IncomingHeadersEventArgs : HttpClientStreamEventArgs
     {
-        public HttpHeader[] Headers { get; private set; }
+        private HttpHeader[] headers;
+
+        // The headers, decoded only as they are read
+        public HttpHeaderCollection HeaderCollection { get; private set; }
         public HeaderBlock Block { get; private set; }
 
-        internal IncomingHeadersEventArgs(HttpClientStream stream, HeaderBlock block, HttpHeader[] headers)
+        // All of the headers, decoded on first access
+        public HttpHeader[] Headers
+        {
+            get
+            {
+                if (headers == null)
+                {
+                    headers = HeaderCollection.ToArray();
+                }
+                return headers;
+            }
+        }
+
+        internal IncomingHeadersEventArgs(HttpClientStream stream, HeaderBlock block, HttpHeaderCollection headers)
             : base(stream)
         {
-            Headers = headers;
+            HeaderCollection = headers;
             Block = block;
         }
     }
@@ -64,15 +80,78 @@ namespace Aws.Crt.Http
         }
     }
 
+    /*
+     * One chunk of a response body.  The chunk's native memory is only valid during the event; Data and PooledData may
+     * be kept.  With HttpResponseStreamHandler.ReuseBodyEventArgs set, a stream reuses the same instance for every
+     * chunk, so the instance may not be kept either.
+     */
     public class IncomingBodyEventArgs : HttpClientStreamEventArgs
     {
-        public byte[] Data { get; private set; }
+        private byte[] data;
+
+        // The chunk in native memory, valid only for the duration of the event
+        public IntPtr NativeData { get; private set; }
+        public int Length { get; private set; }
+
+        // With HttpResponseStreamHandler.BodyBufferPool set, the chunk copied to [0, Length) of a buffer from the pool,
+        // which is then owned by the event handler
+        public byte[] PooledData { get; private set; }
 
-        internal IncomingBodyEventArgs(HttpClientStream stream, byte[] data)
+        // A copy of the chunk, allocated on first access when the instance is reused, otherwise before the event
+        public byte[] Data
+        {
+            get
+            {
+                if (data == null)
+                {
+                    data = new byte[Length];
+                    CopyTo(data, 0);
+                }
+                return data;
+            }
+        }
+
+        internal IncomingBodyEventArgs(HttpClientStream stream)
             : base(stream)
         {
-            Data = data;
         }
+
+        internal void Reset(IntPtr nativeData, int length, IHttpBodyBufferPool pool, bool copyData)
+        {
+            NativeData = nativeData;
+            Length = length;
+            data = null;
+            PooledData = null;
+            if (pool != null)
+            {
+                PooledData = pool.Rent(length);
+                CopyTo(PooledData, 0);
+            }
+            if (copyData)
+            {
+                // Handlers may keep this instance, so Data must outlive the native chunk
+                data = new byte[length];
+                CopyTo(data, 0);
+            }
+        }
+
+        // Copies the chunk into destination at destinationOffset, without allocating
+        public void CopyTo(byte[] destination, int destinationOffset)
+        {
+            if (destination == null)
+                throw new ArgumentNullException("destination");
+            if (destinationOffset < 0 || destinationOffset > destination.Length - Length)
+                throw new ArgumentOutOfRangeException("destinationOffset", destinationOffset, "the chunk must fit in destination");
+
+            Marshal.Copy(NativeData, destination, destinationOffset, Length);
+        }
+    }
+
+    /* Supplies the buffers response body chunks are copied into, e.g. backed by ArrayPool<byte>.Shared */
+    public interface IHttpBodyBufferPool
+    {
+        // Returns a buffer of at least minimumLength bytes
+        byte[] Rent(int minimumLength);
     }
 
     public class StreamCompleteEventArgs : HttpClientStreamEventArgs
@@ -93,6 +172,16 @@ namespace Aws.Crt.Http
         public event EventHandler<IncomingHeadersDoneEventArgs> IncomingHeadersDone;
         public event EventHandler<IncomingBodyEventArgs> IncomingBody;
 
+        /* If set, every body chunk is copied into a buffer rented from this pool (see IncomingBodyEventArgs.PooledData) */
+        public IHttpBodyBufferPool BodyBufferPool { get; set; }
+
+        /*
+         * If set, a stream delivers every body chunk through the same IncomingBodyEventArgs and only copies it to
+         * managed memory on request (Data, CopyTo or BodyBufferPool), so chunks cost no managed allocations.  Handlers
+         * must then not keep the event args past the event.
+         */
+        public bool ReuseBodyEventArgs { get; set; }
+
         internal void Validate()
         {
             if (IncomingHeaders == null)
@@ -106,7 +195,7 @@ namespace Aws.Crt.Http
             StreamComplete?.Invoke(stream, new StreamCompleteEventArgs(stream, errorCode));
         }
 
-        internal void OnIncomingHeaders(HttpClientStream stream, HeaderBlock block, HttpHeader[] headers)
+        internal void OnIncomingHeaders(HttpClientStream stream, HeaderBlock block, HttpHeaderCollection headers)
         {
             IncomingHeaders?.Invoke(stream, new IncomingHeadersEventArgs(stream, block, headers));
         }
@@ -116,10 +205,17 @@ namespace Aws.Crt.Http
             IncomingHeadersDone?.Invoke(stream, new IncomingHeadersDoneEventArgs(stream, block));
         }
 
-        internal void OnIncomingBody(HttpClientStream stream, byte[] data)
+        // reusableArgs is the stream's instance for ReuseBodyEventArgs
+        internal void OnIncomingBody(HttpClientStream stream, IncomingBodyEventArgs reusableArgs, IntPtr data, ulong size)
         {
-            var e = new IncomingBodyEventArgs(stream, data);
-            IncomingBody?.Invoke(stream, e);
+            var incomingBody = IncomingBody;
+            if (incomingBody != null)
+            {
+                bool reuse = ReuseBodyEventArgs;
+                var e = reuse ? reusableArgs : new IncomingBodyEventArgs(stream);
+                e.Reset(data, (int)size, BodyBufferPool, !reuse);
+                incomingBody(stream, e);
+            }
         }
     }
 
@@ -129,6 +225,17 @@ namespace Aws.Crt.Http
         public string Uri { get; set; }
         public HttpHeader[] Headers { get; set; }
         public Stream BodyStream { get; set; }
+
+        /* A body read directly from a file by native code, sent with a Content-Length. Exclusive with BodyStream. */
+        public CrtFileBody BodyFile { get; set; }
+
+        /*
+         * Read BodyStream with ReadAsync rather than Read, so that a body backed by the network or a slow disk never
+         * blocks the event loop that sends it.  Each read is sent as soon as it finishes, as a chunk on HTTP/1.1 or a
+         * DATA frame on HTTP/2, so on HTTP/1.1 the request is sent with Transfer-Encoding: chunked and must not have a
+         * Content-Length.  Signing still reads the body synchronously, on the signing thread.
+         */
+        public bool AsyncBodyReads { get; set; }
     }
 
     [StructLayout(LayoutKind.Sequential, CharSet=CharSet.Ansi)]
@@ -178,6 +285,8 @@ namespace Aws.Crt.Http
     * (both can marshall aws_dotnet_http_header from native).
     * Use HttpHeaderNative in callbacks from native that need to pass array of
     * headers. And HttpHeader otherwise.
+    * HttpHeaderCollection reads arrays of it straight from native memory, and
+    * PackedHttpHeaders builds them to pass request headers to native.
     * Note: HttpHeaderNative holds on to native string pointer, so its only valid
     * while native pointer is valid, i.e. within the callback, and needs to be
     * transformed to HttpHeader if data is used outside of callback scope.
@@ -193,6 +302,15 @@ namespace Aws.Crt.Http
 
         private Int32 valueSize;
 
+        // name and value must stay valid for as long as the header is used
+        public HttpHeaderNative(IntPtr name, Int32 nameSize, IntPtr value, Int32 valueSize)
+        {
+            this.name = name;
+            this.value = value;
+            this.nameSize = nameSize;
+            this.valueSize = valueSize;
+        }
+
         public String Name
         {
             get { return Marshal.PtrToStringAnsi(name, nameSize); }
@@ -212,12 +330,12 @@ namespace Aws.Crt.Http
             internal delegate void OnIncomingHeadersNative(
                                     Int32 responseCode,
                                     [MarshalAs(UnmanagedType.I4)] HeaderBlock headerBlock,
-                                    [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex=3)] HttpHeaderNative[] headers, 
+                                    IntPtr headers,
                                     UInt32 count);
             internal delegate void OnIncomingHeaderBlockDoneNative(
                                     [MarshalAs(UnmanagedType.I4)] HeaderBlock headerBlock);
             internal delegate void OnIncomingBodyNative(
-                                    [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex=1)] byte[] buffer,
+                                    IntPtr buffer,
                                     UInt64 size);
             internal delegate void OnStreamCompleteNative(int errorCode);
 
@@ -228,7 +346,7 @@ namespace Aws.Crt.Http
                                     IntPtr connection,
                                     [MarshalAs(UnmanagedType.LPStr)] string method,
                                     [MarshalAs(UnmanagedType.LPStr)] string uri,
-                                    [In] HttpHeader[] headers,
+                                    [In] HttpHeaderNative[] headers,
                                     UInt32 header_count,
                                     [In] CrtStreamWrapper.DelegateTable streamDelegateTable,
                                     OnIncomingHeadersNative onIncomingHeaders,
@@ -295,12 +413,23 @@ namespace Aws.Crt.Http
         private API.OnStreamCompleteNative onStreamComplete;
 
         internal HttpClientStream(HttpClientConnection connection, HttpRequest request, HttpResponseStreamHandler responseHandler)
+            : this(connection, null, request, responseHandler)
+        {
+        }
+
+        // A stream queued on an HTTP/2 stream manager, which makes and activates it once a connection has room
+        internal HttpClientStream(Http2StreamManager streamManager, HttpRequest request, HttpResponseStreamHandler responseHandler)
+            : this(null, streamManager, request, responseHandler)
+        {
+        }
+
+        private HttpClientStream(HttpClientConnection connection, Http2StreamManager streamManager, HttpRequest request, HttpResponseStreamHandler responseHandler)
             : base(connection)
-        {       
+        {
             responseHandler.Validate();
 
             this.request = request;
-            this.requestBodyStream = new CrtStreamWrapper(request.BodyStream);
+            this.requestBodyStream = new CrtStreamWrapper(request.BodyStream, request.BodyFile, request.AsyncBodyReads);
 
             this.responseHandler = responseHandler;
 
@@ -310,8 +439,7 @@ namespace Aws.Crt.Http
                 if (ResponseStatusCode == 0) {
                     ResponseStatusCode = responseCode;
                 }
-                responseHandler.OnIncomingHeaders(this, block,
-                    Array.ConvertAll(headers, header => new HttpHeader(header.Name, header.Value)));
+                responseHandler.OnIncomingHeaders(this, block, new HttpHeaderCollection(headers, (int)headerCount));
             };
 
             onIncomingHeaderBlockDone = (block) =>
@@ -319,9 +447,10 @@ namespace Aws.Crt.Http
                 responseHandler.OnIncomingHeadersDone(this, block);
             };
 
-            onIncomingBody = (byte[] data, ulong size) =>
+            var incomingBodyEventArgs = new IncomingBodyEventArgs(this);
+            onIncomingBody = (IntPtr data, ulong size) =>
             {
-                responseHandler.OnIncomingBody(this, data);
+                responseHandler.OnIncomingBody(this, incomingBodyEventArgs, data, size);
             };
 
             onStreamComplete = (errorCode) =>
@@ -329,17 +458,36 @@ namespace Aws.Crt.Http
                 responseHandler.OnStreamComplete(this, errorCode);
             };
 
-            NativeHandle = API.make_new(
-                connection.NativeHandle.DangerousGetHandle(),
-                request.Method,
-                request.Uri,
-                request.Headers,
-                (UInt32)(request.Headers?.Length ?? 0),
-                requestBodyStream.Delegates,
-                onIncomingHeaders,
-                onIncomingHeaderBlockDone,
-                onIncomingBody,
-                onStreamComplete);
+            using (var headers = PackedHttpHeaders.Pack(request.Headers))
+            {
+                if (streamManager != null)
+                {
+                    NativeHandle = Http2StreamManager.API.make_request(
+                        streamManager.NativeHandle.DangerousGetHandle(),
+                        request.Method,
+                        request.Uri,
+                        headers.Headers,
+                        headers.Count,
+                        requestBodyStream.Delegates,
+                        onIncomingHeaders,
+                        onIncomingHeaderBlockDone,
+                        onIncomingBody,
+                        onStreamComplete);
+                    return;
+                }
+
+                NativeHandle = API.make_new(
+                    connection.NativeHandle.DangerousGetHandle(),
+                    request.Method,
+                    request.Uri,
+                    headers.Headers,
+                    headers.Count,
+                    requestBodyStream.Delegates,
+                    onIncomingHeaders,
+                    onIncomingHeaderBlockDone,
+                    onIncomingBody,
+                    onStreamComplete);
+            }
         }
 
         public void Activate() 
@@ -376,6 +524,16 @@ namespace Aws.Crt.Http
         public UInt16 Port { get; set; }
         public SocketOptions SocketOptions { get; set; }
         public TlsConnectionOptions TlsConnectionOptions { get; set; }
+
+        /*
+         * Speak HTTP/2 from the start on a plaintext connection (h2c), for servers known to support it.  Over TLS,
+         * HTTP/2 is negotiated instead by listing "h2" in TlsContextOptions.AlpnList.
+         */
+        public bool Http2PriorKnowledge { get; set; }
+
+        // Stop reading a response body once InitialWindowSize bytes of it are unread, until the window is opened with
+        // HttpStream.UpdateWindow, e.g. by an HttpResponseBodyReader
+        public bool ManualWindowManagement { get; set; }
         internal event EventHandler<ConnectionSetupEventArgs> ConnectionSetup;
         public event EventHandler<ConnectionShutdownEventArgs> ConnectionShutdown;
 
@@ -402,6 +560,15 @@ namespace Aws.Crt.Http
         }
     }
 
+    // Must match enum aws_http_version
+    public enum HttpProtocolVersion
+    {
+        Unknown = 0,
+        Http1_0 = 1,
+        Http1_1 = 2,
+        Http2 = 3
+    }
+
     public sealed class HttpClientConnection
     {
         [SecuritySafeCritical]
@@ -420,18 +587,33 @@ namespace Aws.Crt.Http
                                     UInt16 port,
                                     IntPtr socketOptions,
                                     IntPtr tlsConnectionOptions,
+                                    [MarshalAs(UnmanagedType.U1)] bool http2PriorKnowledge,
+                                    [MarshalAs(UnmanagedType.U1)] bool manualWindowManagement,
                                     OnConnectionSetup onSetup,
                                     OnConnectionShutdown onShutdown);
 
             [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
             public delegate void aws_dotnet_http_connection_destroy(IntPtr connection);
 
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            internal delegate Int32 aws_dotnet_http_connection_get_version(IntPtr connection);
+
             public static aws_dotnet_http_connection_new make_new = NativeAPI.Bind<aws_dotnet_http_connection_new>();
             public static aws_dotnet_http_connection_destroy destroy = NativeAPI.Bind<aws_dotnet_http_connection_destroy>();
+            internal static aws_dotnet_http_connection_get_version get_version = NativeAPI.Bind<aws_dotnet_http_connection_get_version>();
         }
 
         internal class Handle : CRT.Handle
         {
+            public Handle()
+            {
+            }
+
+            internal Handle(IntPtr connection)
+            {
+                SetHandle(connection);
+            }
+
             protected override bool ReleaseHandle()
             {
                 API.destroy(handle);
@@ -440,6 +622,10 @@ namespace Aws.Crt.Http
         }
 
         internal Handle NativeHandle { get; private set; }
+
+        // The manager this connection was acquired from, which it is released back to, or null
+        internal HttpClientConnectionManager Manager { get; private set; }
+
         private HttpClientConnectionOptions options;
         // Keep track of streams created by this connection until they complete to
         // keep them from being GC'ed
@@ -457,10 +643,37 @@ namespace Aws.Crt.Http
                 options.Port,
                 options.SocketOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
                 options.TlsConnectionOptions?.NativeHandle.DangerousGetHandle() ?? IntPtr.Zero,
+                options.Http2PriorKnowledge,
+                options.ManualWindowManagement,
                 OnConnectionSetup,
                 OnConnectionShutdown);
         }
 
+        // Wraps a connection acquired from a connection manager
+        internal HttpClientConnection(IntPtr connection, HttpClientConnectionManager manager)
+        {
+            NativeHandle = new Handle(connection);
+            Manager = manager;
+        }
+
+        internal void Release()
+        {
+            NativeHandle.Dispose();
+        }
+
+        // The protocol spoken on the connection, negotiated by ALPN over TLS.  Requests on an HTTP/2 connection are
+        // converted from HTTP/1.1 form, so MakeRequest works the same either way.
+        public HttpProtocolVersion Version
+        {
+            get
+            {
+                if (NativeHandle.IsClosed)
+                    throw new InvalidOperationException("Connection has been released");
+
+                return (HttpProtocolVersion)API.get_version(NativeHandle.DangerousGetHandle());
+            }
+        }
+
         private class ConnectionBootstrap
         {
             public CrtResult<HttpClientConnection> Result = new CrtResult<HttpClientConnection>();
@@ -494,6 +707,9 @@ namespace Aws.Crt.Http
         }
         public CrtResult<StreamResult> MakeRequest(HttpRequest request, HttpResponseStreamHandler responseHandler)
         {
+            if (NativeHandle.IsClosed)
+                throw new InvalidOperationException("Connection has been released");
+
             var bootstrap = new StreamBootstrap();
             responseHandler.StreamComplete += (sender, e) => {
                 streams.Remove(bootstrap.Stream);
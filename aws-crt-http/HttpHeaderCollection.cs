@@ -0,0 +1,312 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Aws.Crt.Http
+{
+    /*
+     * A block of response headers.  The raw header bytes are copied out of native memory in one pass, and names and
+     * values are only decoded into strings when they are asked for.  Well-known header names decode to shared,
+     * interned strings, and looking a header up by name does not allocate.
+     */
+    public sealed class HttpHeaderCollection
+    {
+        // Response headers commonly seen from AWS services; names received in exactly this case or all lower case
+        // decode to these instances
+        private static readonly string[] WellKnownNameStrings = {
+            "Accept-Ranges",
+            "Cache-Control",
+            "Connection",
+            "Content-Disposition",
+            "Content-Encoding",
+            "Content-Language",
+            "Content-Length",
+            "Content-MD5",
+            "Content-Range",
+            "Content-Type",
+            "Date",
+            "ETag",
+            "Expires",
+            "Keep-Alive",
+            "Last-Modified",
+            "Location",
+            "Retry-After",
+            "Server",
+            "Transfer-Encoding",
+            "Vary",
+            "x-amz-checksum-crc32",
+            "x-amz-checksum-crc32c",
+            "x-amz-checksum-sha1",
+            "x-amz-checksum-sha256",
+            "x-amz-crc32",
+            "x-amz-delete-marker",
+            "x-amz-expiration",
+            "x-amz-id-2",
+            "x-amz-request-id",
+            "x-amz-server-side-encryption",
+            "x-amz-storage-class",
+            "x-amz-version-id",
+            "x-amzn-ErrorType",
+            "x-amzn-RequestId",
+        };
+
+        private static readonly string[][] WellKnownNamesByLength = BuildWellKnownNames();
+
+        private static readonly int HeaderSize = Marshal.SizeOf(typeof(HttpHeaderNative));
+        private static readonly int NameOffset = Marshal.OffsetOf(typeof(HttpHeaderNative), "name").ToInt32();
+        private static readonly int ValueOffset = Marshal.OffsetOf(typeof(HttpHeaderNative), "value").ToInt32();
+        private static readonly int NameSizeOffset = Marshal.OffsetOf(typeof(HttpHeaderNative), "nameSize").ToInt32();
+        private static readonly int ValueSizeOffset = Marshal.OffsetOf(typeof(HttpHeaderNative), "valueSize").ToInt32();
+
+        // Header i's name is bytes[offsets[2 * i], offsets[2 * i + 1]) and its value runs from there to offsets[2 * i + 2]
+        private readonly byte[] bytes;
+        private readonly int[] offsets;
+
+        // Decoded names and values, filled in as they are asked for
+        private string[] names;
+        private string[] values;
+
+        public int Count { get; private set; }
+
+        public HttpHeader this[int index]
+        {
+            get { return new HttpHeader(GetName(index), GetValue(index)); }
+        }
+
+        // Copies count aws_dotnet_http_header structs, and the strings they point to, out of native memory
+        internal HttpHeaderCollection(IntPtr headers, int count)
+        {
+            Count = count;
+            offsets = new int[2 * count + 1];
+
+            int size = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                IntPtr header = new IntPtr(headers.ToInt64() + (long)i * HeaderSize);
+                size += Marshal.ReadInt32(header, NameSizeOffset) + Marshal.ReadInt32(header, ValueSizeOffset);
+            }
+
+            bytes = new byte[size];
+            int position = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                IntPtr header = new IntPtr(headers.ToInt64() + (long)i * HeaderSize);
+                offsets[2 * i] = position;
+                position += CopyField(header, NameOffset, NameSizeOffset, position);
+                offsets[2 * i + 1] = position;
+                position += CopyField(header, ValueOffset, ValueSizeOffset, position);
+            }
+            offsets[2 * count] = position;
+        }
+
+        private int CopyField(IntPtr header, int pointerOffset, int sizeOffset, int position)
+        {
+            int fieldSize = Marshal.ReadInt32(header, sizeOffset);
+            if (fieldSize > 0)
+            {
+                Marshal.Copy(Marshal.ReadIntPtr(header, pointerOffset), bytes, position, fieldSize);
+            }
+            return fieldSize;
+        }
+
+        public string GetName(int index)
+        {
+            CheckIndex(index);
+            if (names == null)
+            {
+                names = new string[Count];
+            }
+            if (names[index] == null)
+            {
+                int start = offsets[2 * index];
+                int length = offsets[2 * index + 1] - start;
+                names[index] = FindWellKnownName(start, length) ?? Encoding.UTF8.GetString(bytes, start, length);
+            }
+            return names[index];
+        }
+
+        public string GetValue(int index)
+        {
+            CheckIndex(index);
+            if (values == null)
+            {
+                values = new string[Count];
+            }
+            if (values[index] == null)
+            {
+                int start = offsets[2 * index + 1];
+                values[index] = Encoding.UTF8.GetString(bytes, start, offsets[2 * index + 2] - start);
+            }
+            return values[index];
+        }
+
+        // Returns the index of the first header with the given name, compared case-insensitively, or -1
+        public int IndexOf(string name)
+        {
+            if (name == null)
+                throw new ArgumentNullException("name");
+
+            for (int i = 0; i < Count; ++i)
+            {
+                if (NameEquals(i, name))
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        public bool Contains(string name)
+        {
+            return IndexOf(name) >= 0;
+        }
+
+        public bool TryGetValue(string name, out string value)
+        {
+            int index = IndexOf(name);
+            value = index >= 0 ? GetValue(index) : null;
+            return index >= 0;
+        }
+
+        // Parses the value of the named header, e.g. Content-Length, as a non-negative decimal number without decoding it
+        public bool TryGetInt64(string name, out long value)
+        {
+            value = 0;
+            int index = IndexOf(name);
+            if (index < 0)
+            {
+                return false;
+            }
+
+            int start = offsets[2 * index + 1];
+            int end = offsets[2 * index + 2];
+            while (start < end && IsWhitespace(bytes[start]))
+            {
+                ++start;
+            }
+            while (end > start && IsWhitespace(bytes[end - 1]))
+            {
+                --end;
+            }
+            if (start == end)
+            {
+                return false;
+            }
+
+            long result = 0;
+            for (int i = start; i < end; ++i)
+            {
+                int digit = bytes[i] - '0';
+                if (digit < 0 || digit > 9 || result > (long.MaxValue - digit) / 10)
+                {
+                    return false;
+                }
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
+        }
+
+        public HttpHeader[] ToArray()
+        {
+            var headers = new HttpHeader[Count];
+            for (int i = 0; i < Count; ++i)
+            {
+                headers[i] = this[i];
+            }
+            return headers;
+        }
+
+        private void CheckIndex(int index)
+        {
+            if (index < 0 || index >= Count)
+                throw new ArgumentOutOfRangeException("index", index, "index must be less than Count");
+        }
+
+        // Header names are ASCII, so anything else only matches byte for byte
+        private bool NameEquals(int index, string name)
+        {
+            int start = offsets[2 * index];
+            if (offsets[2 * index + 1] - start != name.Length)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < name.Length; ++i)
+            {
+                char c = name[i];
+                if (c > 0x7F || ToLowerAscii(bytes[start + i]) != ToLowerAscii((byte)c))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        private string FindWellKnownName(int start, int length)
+        {
+            if (length >= WellKnownNamesByLength.Length || WellKnownNamesByLength[length] == null)
+            {
+                return null;
+            }
+
+            foreach (var candidate in WellKnownNamesByLength[length])
+            {
+                int i = 0;
+                while (i < length && bytes[start + i] == candidate[i])
+                {
+                    ++i;
+                }
+                if (i == length)
+                {
+                    return candidate;
+                }
+            }
+            return null;
+        }
+
+        private static byte ToLowerAscii(byte c)
+        {
+            return (c >= 'A' && c <= 'Z') ? (byte)(c + ('a' - 'A')) : c;
+        }
+
+        private static bool IsWhitespace(byte c)
+        {
+            return c == ' ' || c == '\t';
+        }
+
+        private static string[][] BuildWellKnownNames()
+        {
+            var byLength = new Dictionary<int, List<string>>();
+            int maxLength = 0;
+            foreach (var name in WellKnownNameStrings)
+            {
+                var lowerCase = string.Intern(name.ToLowerInvariant());
+                var forms = lowerCase == name ? new string[] { lowerCase } : new string[] { string.Intern(name), lowerCase };
+                foreach (var form in forms)
+                {
+                    List<string> sameLength;
+                    if (!byLength.TryGetValue(form.Length, out sameLength))
+                    {
+                        sameLength = new List<string>();
+                        byLength[form.Length] = sameLength;
+                    }
+                    sameLength.Add(form);
+                }
+                maxLength = Math.Max(maxLength, name.Length);
+            }
+
+            var result = new string[maxLength + 1][];
+            foreach (var entry in byLength)
+            {
+                result[entry.Key] = entry.Value.ToArray();
+            }
+            return result;
+        }
+    }
+}
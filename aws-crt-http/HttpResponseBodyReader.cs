@@ -0,0 +1,230 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+using Aws.Crt;
+
+namespace Aws.Crt.Http
+{
+    /*
+     * A response body pulled with Read instead of pushed through IncomingBody.  Chunks are buffered as they arrive,
+     * and the stream's flow-control window is reopened by as much as the consumer reads.  With ManualWindowManagement
+     * on the connection, at most InitialWindowSize bytes are ever buffered, and a slow consumer slows the socket down
+     * rather than growing memory: InitialWindowSize alone trades memory for throughput.  Without it, the window is
+     * never closed, and the buffer grows as far as the consumer falls behind.
+     *
+     * Read blocks until data arrives, so it must not be called from within the stream's events, which are raised on
+     * the event loop that delivers the data.  Disposing the reader before the end discards the rest of the body, which
+     * is still received so the connection can be reused.
+     */
+    public sealed class HttpResponseBodyReader : Stream
+    {
+        // Reads returning less than this to the window are batched until the buffer runs dry, to save native calls
+        private const int MinWindowUpdate = 16 * 1024;
+        private const int MinCapacity = 4 * 1024;
+
+        // All guarded by sync
+        private object sync = new object();
+        // A ring buffer: [head, head + count) modulo its length is unread.  Only ever grown, to fit the window.
+        private byte[] buffer = new byte[0];
+        private int head;
+        private int count;
+        // Read since the window was last opened
+        private ulong unacknowledged;
+        private HttpStream stream;
+        private bool complete;
+        private int errorCode;
+        private bool disposed;
+
+        // Reads the body of the response handled by responseHandler, which must not be used for another request.  The
+        // reader copies each chunk out of its native memory, so it turns on ReuseBodyEventArgs, and any other handlers
+        // of IncomingBody must not keep the event args either.
+        public HttpResponseBodyReader(HttpResponseStreamHandler responseHandler)
+        {
+            if (responseHandler == null)
+                throw new ArgumentNullException("responseHandler");
+
+            responseHandler.ReuseBodyEventArgs = true;
+            responseHandler.IncomingBody += OnIncomingBody;
+            responseHandler.StreamComplete += OnStreamComplete;
+        }
+
+        public override bool CanRead { get { return true; } }
+        public override bool CanSeek { get { return false; } }
+        public override bool CanWrite { get { return false; } }
+
+        public override long Length { get { throw new NotSupportedException(); } }
+
+        public override long Position
+        {
+            get { throw new NotSupportedException(); }
+            set { throw new NotSupportedException(); }
+        }
+
+        // Blocks until at least one byte is available, and returns 0 at the end of the body
+        public override int Read(byte[] destination, int offset, int length)
+        {
+            if (destination == null)
+                throw new ArgumentNullException("destination");
+            if (offset < 0 || length < 0 || offset > destination.Length - length)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset and length must lie within destination");
+
+            int read;
+            ulong windowUpdate = 0;
+            HttpStream windowStream;
+            lock (sync)
+            {
+                while (count == 0 && !complete && !disposed)
+                {
+                    Monitor.Wait(sync);
+                }
+
+                if (disposed)
+                    throw new ObjectDisposedException("HttpResponseBodyReader");
+
+                if (count == 0)
+                {
+                    if (errorCode != 0)
+                        throw new IOException(String.Format("Response body failed: {0}", CRT.ErrorString(errorCode)));
+                    return 0;
+                }
+
+                read = Math.Min(length, count);
+                int first = Math.Min(read, buffer.Length - head);
+                Buffer.BlockCopy(buffer, head, destination, offset, first);
+                Buffer.BlockCopy(buffer, 0, destination, offset + first, read - first);
+                head = (head + read) % buffer.Length;
+                count -= read;
+
+                unacknowledged += (ulong)read;
+                if (!complete && (unacknowledged >= MinWindowUpdate || count == 0))
+                {
+                    windowUpdate = unacknowledged;
+                    unacknowledged = 0;
+                }
+                windowStream = stream;
+            }
+
+            if (windowUpdate > 0)
+            {
+                windowStream.UpdateWindow(windowUpdate);
+            }
+            return read;
+        }
+
+        public override void Flush()
+        {
+        }
+
+        public override long Seek(long offset, SeekOrigin origin)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override void SetLength(long value)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override void Write(byte[] source, int offset, int length)
+        {
+            throw new NotSupportedException();
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            ulong windowUpdate = 0;
+            HttpStream windowStream;
+            lock (sync)
+            {
+                if (disposed)
+                {
+                    return;
+                }
+
+                disposed = true;
+                if (!complete)
+                {
+                    windowUpdate = unacknowledged + (ulong)count;
+                }
+                unacknowledged = 0;
+                count = 0;
+                buffer = new byte[0];
+                windowStream = stream;
+                Monitor.PulseAll(sync);
+            }
+
+            if (windowUpdate > 0 && windowStream != null)
+            {
+                windowStream.UpdateWindow(windowUpdate);
+            }
+            base.Dispose(disposing);
+        }
+
+        private void OnIncomingBody(object sender, IncomingBodyEventArgs e)
+        {
+            lock (sync)
+            {
+                stream = e.Stream;
+                if (!disposed)
+                {
+                    Append(e.NativeData, e.Length);
+                    Monitor.PulseAll(sync);
+                    return;
+                }
+            }
+
+            // Discarded, so the window is reopened straight away
+            e.Stream.UpdateWindow((ulong)e.Length);
+        }
+
+        private void OnStreamComplete(object sender, StreamCompleteEventArgs e)
+        {
+            lock (sync)
+            {
+                complete = true;
+                errorCode = e.ErrorCode;
+                Monitor.PulseAll(sync);
+            }
+        }
+
+        // Must be called under the lock
+        private void Append(IntPtr data, int length)
+        {
+            if (length == 0)
+            {
+                return;
+            }
+
+            if (count + length > buffer.Length)
+            {
+                int capacity = Math.Max(buffer.Length, MinCapacity);
+                while (capacity < count + length)
+                {
+                    capacity *= 2;
+                }
+
+                var grown = new byte[capacity];
+                int first = Math.Min(count, buffer.Length - head);
+                Buffer.BlockCopy(buffer, head, grown, 0, first);
+                Buffer.BlockCopy(buffer, 0, grown, first, count - first);
+                buffer = grown;
+                head = 0;
+            }
+
+            int tail = (head + count) % buffer.Length;
+            int firstPart = Math.Min(length, buffer.Length - tail);
+            Marshal.Copy(data, buffer, tail, firstPart);
+            if (length > firstPart)
+            {
+                Marshal.Copy(new IntPtr(data.ToInt64() + firstPart), buffer, 0, length - firstPart);
+            }
+            count += length;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Aws.Crt.Http
+{
+    /*
+     * Request headers packed for native code.  Names and values are UTF-8 encoded back to back into one pinned buffer,
+     * and Headers holds an aws_dotnet_http_header for each that points into it with an explicit length, so native code
+     * builds cursors straight from the buffer.  Native code must be done with the headers when the call they are
+     * passed to returns, since disposing hands the buffers back for the next packing on the same thread.
+     * aws-crt-auth compiles this file in as well, so that it stays internal to each assembly.
+     */
+    internal sealed class PackedHttpHeaders : IDisposable
+    {
+        [ThreadStatic]
+        private static PackedHttpHeaders threadCache;
+
+        private byte[] bytes = new byte[0];
+        private GCHandle pin;
+        private bool inUse;
+
+        // Only the first Count entries are in use
+        public HttpHeaderNative[] Headers { get; private set; }
+        public uint Count { get; private set; }
+
+        private PackedHttpHeaders()
+        {
+            Headers = new HttpHeaderNative[0];
+        }
+
+        // headers may be null, for no headers
+        public static PackedHttpHeaders Pack(HttpHeader[] headers)
+        {
+            // A packing still in use further up the stack, e.g. while a completion callback signs another request,
+            // keeps its buffers
+            var packed = threadCache;
+            if (packed == null || packed.inUse)
+            {
+                packed = new PackedHttpHeaders();
+                if (threadCache == null)
+                {
+                    threadCache = packed;
+                }
+            }
+
+            packed.Fill(headers);
+            return packed;
+        }
+
+        private void Fill(HttpHeader[] headers)
+        {
+            int count = headers != null ? headers.Length : 0;
+
+            int capacity = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (headers[i].Name == null)
+                    throw new ArgumentException("header names must not be null", "headers");
+
+                capacity += Encoding.UTF8.GetMaxByteCount(headers[i].Name.Length);
+                capacity += Encoding.UTF8.GetMaxByteCount(headers[i].Value != null ? headers[i].Value.Length : 0);
+            }
+
+            if (bytes.Length < capacity)
+            {
+                bytes = new byte[capacity];
+            }
+            if (Headers.Length < count)
+            {
+                Headers = new HttpHeaderNative[count];
+            }
+
+            inUse = true;
+            pin = GCHandle.Alloc(bytes, GCHandleType.Pinned);
+            long address = pin.AddrOfPinnedObject().ToInt64();
+
+            int position = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                int nameStart = position;
+                position += Encoding.UTF8.GetBytes(headers[i].Name, 0, headers[i].Name.Length, bytes, position);
+                int valueStart = position;
+                if (headers[i].Value != null)
+                {
+                    position += Encoding.UTF8.GetBytes(headers[i].Value, 0, headers[i].Value.Length, bytes, position);
+                }
+
+                Headers[i] = new HttpHeaderNative(new IntPtr(address + nameStart), valueStart - nameStart,
+                    new IntPtr(address + valueStart), position - valueStart);
+            }
+            Count = (uint)count;
+        }
+
+        public void Dispose()
+        {
+            if (!inUse)
+            {
+                return;
+            }
+
+            pin.Free();
+            Count = 0;
+            inUse = false;
+        }
+    }
+}
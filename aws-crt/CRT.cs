@@ -4,15 +4,29 @@
  */
 using System;
 using System.ComponentModel;
+using System.Diagnostics;
 using System.IO;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Security;
+using System.Security.Cryptography;
 using System.Threading;
 
 namespace Aws.Crt
 {
+    public enum NativeLibrarySource
+    {
+        // Loaded from the path in AWS_CRT_DOTNET_LIBRARY_PATH
+        Configured,
+        // Loaded from the directory containing the AWSCRT assembly
+        ApplicationDirectory,
+        // Loaded from, and extracted to if necessary, the content-addressed cache in AWS_CRT_DOTNET_LIBRARY_CACHE_DIR
+        ExtractionCache,
+        // Extracted to a new temp file, which is deleted when the library is unloaded
+        Extracted
+    }
+
     [SecuritySafeCritical]
     public static class CRT
     {
@@ -89,6 +103,22 @@ namespace Aws.Crt
             API.native_memory_dump();
         }
 
+        public static string NativeLibraryPath
+        {
+            get { return Binding.LibraryPath; }
+        }
+
+        public static NativeLibrarySource NativeLibrarySource
+        {
+            get { return Binding.LibrarySource; }
+        }
+
+        // Time spent locating, extracting, loading and initializing the native library
+        public static TimeSpan NativeLibraryLoadTime
+        {
+            get { return Binding.LoadTime; }
+        }
+
         internal class LibraryHandle : Handle
         {
             private string libraryPath;
@@ -98,9 +128,16 @@ namespace Aws.Crt
                 SetHandle(value);
             }
 
+            // Only libraries extracted to a private temp file are deleted, cached or configured libraries are shared
+            internal bool DeleteOnRelease { get; set; }
+
             protected override bool ReleaseHandle()
             {
                 CRT.Loader.FreeLibrary(handle);
+                if (!DeleteOnRelease) {
+                    return true;
+                }
+
                 // No longer need the library file, delete it
                 try {
                     File.Delete(libraryPath);
@@ -122,9 +159,18 @@ namespace Aws.Crt
 
         internal class PlatformBinding
         {
+            // Path to a prebuilt native library, or a directory containing it, which is loaded as is
+            internal const string LibraryPathEnvironmentVariable = "AWS_CRT_DOTNET_LIBRARY_PATH";
+            // Directory in which the embedded native library is extracted once, named by its content hash, and reused
+            internal const string LibraryCacheDirEnvironmentVariable = "AWS_CRT_DOTNET_LIBRARY_CACHE_DIR";
+
             private LibraryHandle crt;
             private string libraryPath;
 
+            public string LibraryPath { get { return libraryPath; } }
+            public NativeLibrarySource LibrarySource { get; private set; }
+            public TimeSpan LoadTime { get; private set; }
+
 /*
  * We build for net35, net45 and netstandard2 and this did not become available until net47ish
 */
@@ -157,20 +203,34 @@ namespace Aws.Crt
                         break;
                 }
 
+                var timer = Stopwatch.StartNew();
                 try
                 {
-                    libraryPath = ExtractLibrary(libraryName);
-
-                    // Work around virus scanners munching on a newly found DLL
-                    int tries = 0;
-                    do
+                    string cacheDir = Environment.GetEnvironmentVariable(LibraryCacheDirEnvironmentVariable);
+                    if ((libraryPath = FindConfiguredLibrary(libraryName)) != null)
                     {
+                        LibrarySource = NativeLibrarySource.Configured;
                         crt = CRT.Loader.LoadLibrary(libraryPath);
-                        if (crt.IsInvalid)
-                        {
-                            Thread.Sleep(10);
-                        }
-                    } while (crt.IsInvalid && tries++ < 100);
+                    }
+                    else if ((libraryPath = FindApplicationLibrary(libraryName)) != null)
+                    {
+                        LibrarySource = NativeLibrarySource.ApplicationDirectory;
+                        crt = CRT.Loader.LoadLibrary(libraryPath);
+                    }
+                    else if (!String.IsNullOrEmpty(cacheDir))
+                    {
+                        bool extracted;
+                        libraryPath = ExtractCachedLibrary(libraryName, cacheDir, out extracted);
+                        LibrarySource = NativeLibrarySource.ExtractionCache;
+                        crt = extracted ? LoadNewLibrary(libraryPath) : CRT.Loader.LoadLibrary(libraryPath);
+                    }
+                    else
+                    {
+                        libraryPath = ExtractLibrary(libraryName);
+                        LibrarySource = NativeLibrarySource.Extracted;
+                        crt = LoadNewLibrary(libraryPath);
+                        crt.DeleteOnRelease = true;
+                    }
 
                     if (crt.IsInvalid)
                     {
@@ -184,6 +244,7 @@ namespace Aws.Crt
                 }
 
                 Init();
+                LoadTime = timer.Elapsed;
             }
 
             ~PlatformBinding()
@@ -191,19 +252,198 @@ namespace Aws.Crt
                 Shutdown();
             }
 
+            private LibraryHandle LoadNewLibrary(string path)
+            {
+                // Work around virus scanners munching on a newly found DLL
+                LibraryHandle library = null;
+                int tries = 0;
+                do
+                {
+                    library = CRT.Loader.LoadLibrary(path);
+                    if (library.IsInvalid)
+                    {
+                        Thread.Sleep(10);
+                    }
+                } while (library.IsInvalid && tries++ < 100);
+
+                return library;
+            }
+
+            private static string FindConfiguredLibrary(string libraryName)
+            {
+                string configuredPath = Environment.GetEnvironmentVariable(LibraryPathEnvironmentVariable);
+                if (String.IsNullOrEmpty(configuredPath))
+                {
+                    return null;
+                }
+
+                string path = Directory.Exists(configuredPath) ? Path.Combine(configuredPath, libraryName) : configuredPath;
+                if (!File.Exists(path))
+                {
+                    throw new FileNotFoundException($"{LibraryPathEnvironmentVariable} is set, but {path} does not exist", path);
+                }
+
+                return Path.GetFullPath(path);
+            }
+
+            private static string FindApplicationLibrary(string libraryName)
+            {
+                string location = Assembly.GetAssembly(typeof(CRT)).Location;
+                if (String.IsNullOrEmpty(location))
+                {
+                    return null;
+                }
+
+                string path = Path.Combine(Path.GetDirectoryName(location), libraryName);
+                return File.Exists(path) ? path : null;
+            }
+
+            private static Stream OpenLibraryResource(Assembly crtAsm, string libraryName)
+            {
+                var resourceStream = crtAsm.GetManifestResourceStream("Aws.CRT." + libraryName);
+                if (resourceStream == null)
+                {
+                    var resources = crtAsm.GetManifestResourceNames();
+                    var resourceList = String.Join(",", resources);
+                    throw new IOException($"Could not find {libraryName} in resource manifest; Resources={resourceList}");
+                }
+
+                return resourceStream;
+            }
+
+            private static string Sha256Hex(Stream stream)
+            {
+                using (var sha256 = SHA256.Create())
+                {
+                    return BitConverter.ToString(sha256.ComputeHash(stream)).Replace("-", "").ToLowerInvariant();
+                }
+            }
+
+            // True if path holds exactly the library whose SHA-256 is digest
+            private static bool IsIntactLibrary(string path, string digest)
+            {
+                try
+                {
+                    using (var cachedStream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+                    {
+                        return Sha256Hex(cachedStream) == digest;
+                    }
+                }
+                catch (FileNotFoundException)
+                {
+                    return false;
+                }
+            }
+
+            // The SHA-256 of the embedded library, computed when it was embedded, or null if the build didn't
+            private static string ReadLibraryDigest(Assembly crtAsm, string libraryName)
+            {
+                using (var digestStream = crtAsm.GetManifestResourceStream("Aws.CRT." + libraryName + ".sha256"))
+                {
+                    if (digestStream == null)
+                    {
+                        return null;
+                    }
+
+                    using (var reader = new StreamReader(digestStream))
+                    {
+                        return reader.ReadToEnd().Trim().ToLowerInvariant();
+                    }
+                }
+            }
+
+            /*
+             * Extracts library into cacheDir as <sha256 of the library>.<libraryName>, unless a previous process already
+             * did so.  digest is the library's SHA-256, or null to compute it.  The library is written to a private temp
+             * file and renamed into place, so a file under the final name is always complete.  A cached file is only
+             * reused once its own SHA-256 matches, so an entry that was truncated or corrupted after the fact is
+             * replaced rather than loaded.  Concurrent extractors check again just before replacing, and one that
+             * can't replace the file, e.g. because another process has since loaded its copy, uses that copy if it is
+             * intact.
+             */
+            internal static string ExtractCachedLibrary(Stream library, string digest, string libraryName, string cacheDir, out bool extracted)
+            {
+                extracted = false;
+                if (digest == null)
+                {
+                    digest = Sha256Hex(library);
+                    library.Seek(0, SeekOrigin.Begin);
+                }
+
+                Directory.CreateDirectory(cacheDir);
+                var cachedLibraryPath = Path.Combine(cacheDir, digest.Substring(0, 32) + "." + libraryName);
+                if (IsIntactLibrary(cachedLibraryPath, digest))
+                {
+                    return cachedLibraryPath;
+                }
+
+                var extractedLibraryPath = cachedLibraryPath + "." + Path.GetRandomFileName() + ".tmp";
+                try
+                {
+                    using (var libStream = new FileStream(extractedLibraryPath, FileMode.CreateNew, FileAccess.Write))
+                    {
+                        CopyStream(library, libStream, 0);
+                    }
+
+                    // Another process may have put an intact copy in place, and loaded it, while this one was copying
+                    if (IsIntactLibrary(cachedLibraryPath, digest))
+                    {
+                        return cachedLibraryPath;
+                    }
+
+                    try
+                    {
+                        if (File.Exists(cachedLibraryPath))
+                        {
+                            File.Replace(extractedLibraryPath, cachedLibraryPath, null);
+                        }
+                        else
+                        {
+                            File.Move(extractedLibraryPath, cachedLibraryPath);
+                        }
+                        extracted = true;
+                    }
+                    catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+                    {
+                        // Another process won the race, and may have loaded its copy, so use that
+                        if (!IsIntactLibrary(cachedLibraryPath, digest))
+                        {
+                            throw;
+                        }
+                    }
+                    return cachedLibraryPath;
+                }
+                catch (Exception ex)
+                {
+                    throw new InvalidOperationException($"Could not extract {libraryName} to {cachedLibraryPath}", ex);
+                }
+                finally
+                {
+                    try {
+                        File.Delete(extractedLibraryPath);
+                    }
+                    catch (Exception) {
+                        // best effort, just ignore it
+                    }
+                }
+            }
+
+            private string ExtractCachedLibrary(string libraryName, string cacheDir, out bool extracted)
+            {
+                var crtAsm = Assembly.GetAssembly(typeof(CRT));
+                using (var resourceStream = OpenLibraryResource(crtAsm, libraryName))
+                {
+                    return ExtractCachedLibrary(resourceStream, ReadLibraryDigest(crtAsm, libraryName), libraryName, cacheDir, out extracted);
+                }
+            }
+
             private string ExtractLibrary(string libraryName)
             {
                 var crtAsm = Assembly.GetAssembly(typeof(CRT));
                 Stream resourceStream = null;
                 try
                 {
-                    resourceStream = crtAsm.GetManifestResourceStream("Aws.CRT." + libraryName);
-                    if (resourceStream == null)
-                    {
-                        var resources = crtAsm.GetManifestResourceNames();
-                        var resourceList = String.Join(",", resources);
-                        throw new IOException($"Could not find {libraryName} in resource manifest; Resources={resourceList}");
-                    }
+                    resourceStream = OpenLibraryResource(crtAsm, libraryName);
                     string prefix = Path.GetRandomFileName();
                     var extractedLibraryPath = Path.GetTempPath() + prefix + "." + libraryName;
                     FileStream libStream = null;
@@ -0,0 +1,37 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+
+namespace Aws.Crt.IO
+{
+    /*
+     * A request body that is a range of a file, read directly by native code rather than through a managed Stream.
+     * The file is opened when the body is handed to native code, by making or signing a request, and its length is
+     * known up front.
+     */
+    public sealed class CrtFileBody
+    {
+        // Passed as length to use the rest of the file after offset
+        public const long ToEnd = -1;
+
+        public string Path { get; private set; }
+        public long Offset { get; private set; }
+        public long Length { get; private set; }
+
+        public CrtFileBody(string path, long offset = 0, long length = ToEnd)
+        {
+            if (path == null)
+                throw new ArgumentNullException("path");
+            if (offset < 0)
+                throw new ArgumentOutOfRangeException("offset", offset, "offset must not be negative");
+            if (length < 0 && length != ToEnd)
+                throw new ArgumentOutOfRangeException("length", length, "length must not be negative");
+
+            Path = path;
+            Offset = offset;
+            Length = length;
+        }
+    }
+}
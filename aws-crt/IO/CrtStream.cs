@@ -1,6 +1,11 @@
 using System;
 using System.IO;
 using System.Runtime.InteropServices;
+using System.Security;
+using System.Text;
+#if !BCL35
+using System.Threading.Tasks;
+#endif
 
 using Aws.Crt;
 
@@ -8,6 +13,19 @@ namespace Aws.Crt.IO
 {
     public sealed class CrtStreamWrapper
     {
+        [SecuritySafeCritical]
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate void aws_dotnet_async_input_stream_complete_read(
+                                    IntPtr stream,
+                                    UInt64 bytesRead,
+                                    [MarshalAs(UnmanagedType.U1)] bool endOfStream,
+                                    [MarshalAs(UnmanagedType.U1)] bool failed);
+
+            public static aws_dotnet_async_input_stream_complete_read complete_read = NativeAPI.Bind<aws_dotnet_async_input_stream_complete_read>();
+        }
+
         public enum StreamState 
         {
             InProgress = 0,
@@ -20,23 +38,70 @@ namespace Aws.Crt.IO
             End = 2
         }
 
+        /* buffer is the unused tail of the native destination buffer, which the read fills directly */
         public delegate int CrtStreamReadCallback(
-                        [In, Out, MarshalAs(UnmanagedType.LPArray, SizeParamIndex=1)] byte[] buffer, 
+                        IntPtr buffer,
                         UInt64 size,
                         out UInt64 bytesWritten);
         public delegate bool CrtStreamSeekCallback(Int64 offset, int basis);
+        public delegate bool CrtStreamGetLengthCallback(out Int64 length);
+        /* Starts a read into buffer and returns; the read is finished later with complete_read(stream, ...) */
+        public delegate void CrtStreamAsyncReadCallback(IntPtr stream, IntPtr buffer, UInt64 size);
 
         [StructLayout(LayoutKind.Sequential, CharSet=CharSet.Ansi)]
         public struct DelegateTable
         {
             public CrtStreamReadCallback ReadCallback;
             public CrtStreamSeekCallback SeekCallback;
+            public CrtStreamGetLengthCallback GetLengthCallback;
+            /* Set for bodies read asynchronously, which native code reads without ReadCallback or SeekCallback */
+            public CrtStreamAsyncReadCallback AsyncReadCallback;
+
+            /*
+             * Set for file backed bodies, which native code reads without the callbacks.  A NUL terminated UTF-8 path,
+             * as aws_fopen expects, owned by the wrapper.
+             */
+            public IntPtr FilePath;
+            public Int64 FileOffset;
+            public Int64 FileLength;
         }
 
+        // Largest scratch buffer used to move data from a Stream to native memory
+        private const int MaxScratchBufferSize = 64 * 1024;
+
+        /*
+         * Reads run on event loop threads, of which there are few, so a scratch buffer per thread is shared by every
+         * stream instead of allocating on each read
+         */
+        [ThreadStatic]
+        private static byte[] scratchBuffer;
+
         private Stream BodyStream;
 
+        /* Async reads finish on other threads, so each stream has its own buffer; only one read is in flight at once */
+        private byte[] asyncReadBuffer;
+
         public DelegateTable Delegates { get; private set; }
 
+        /* Native copy of a file body's path, which Delegates points to */
+        private class FilePathHandle : CRT.Handle
+        {
+            public FilePathHandle(string path)
+            {
+                byte[] bytes = Encoding.UTF8.GetBytes(path + "\0");
+                SetHandle(Marshal.AllocHGlobal(bytes.Length));
+                Marshal.Copy(bytes, 0, handle, bytes.Length);
+            }
+
+            protected override bool ReleaseHandle()
+            {
+                Marshal.FreeHGlobal(handle);
+                return true;
+            }
+        }
+
+        private FilePathHandle filePath;
+
         private SeekOrigin SeekBasisToSeekOrigin(SeekBasis basis) {
             switch(basis) {
                 case SeekBasis.Begin:
@@ -64,37 +129,187 @@ namespace Aws.Crt.IO
             return false;
         }
 
-        private int ReadInternal(byte[] buffer, ulong size, out ulong bytesWritten) {
+        private int ReadInternal(IntPtr buffer, ulong size, out ulong bytesWritten) {
             bytesWritten = 0;
-            if (BodyStream != null)
+            if (BodyStream == null)
+            {
+                return (int) StreamState.Done;
+            }
+
+            int count = (int)Math.Min(size, (ulong)int.MaxValue);
+            bool endOfStream;
+            int read;
+            if (!TryReadMemoryStream(buffer, count, out read, out endOfStream))
+            {
+                read = ReadStream(buffer, count, out endOfStream);
+            }
+
+            bytesWritten = (ulong)read;
+            if (!endOfStream && BodyStream.CanSeek)
+            {
+                endOfStream = BodyStream.Position == BodyStream.Length;
+            }
+
+            return (int)(endOfStream ? StreamState.Done : StreamState.InProgress);
+        }
+
+        // MemoryStreams that expose their buffer are copied to native memory straight from it
+        private bool TryReadMemoryStream(IntPtr buffer, int count, out int read, out bool endOfStream) {
+            read = 0;
+            endOfStream = false;
+#if !NETSTANDARD
+            /* MemoryStream.TryGetBuffer is not available before .NET Framework 4.6 */
+            return false;
+#else
+            /* Subclasses may override Read, so only plain MemoryStreams are read from their buffer */
+            var memoryStream = BodyStream as MemoryStream;
+            ArraySegment<byte> contents;
+            if (memoryStream == null || memoryStream.GetType() != typeof(MemoryStream) || !memoryStream.TryGetBuffer(out contents))
+            {
+                return false;
+            }
+
+            long position = memoryStream.Position;
+            read = (int)Math.Max(0, Math.Min(count, contents.Count - position));
+            Marshal.Copy(contents.Array, contents.Offset + (int)position, buffer, read);
+            memoryStream.Position = position + read;
+            endOfStream = memoryStream.Position >= contents.Count;
+            return true;
+#endif
+        }
+
+        // Fills buffer from the stream through the thread's scratch buffer, stopping early only at the end of the stream
+        private int ReadStream(IntPtr buffer, int count, out bool endOfStream) {
+            endOfStream = false;
+            byte[] scratch = scratchBuffer;
+            int scratchSize = Math.Min(count, MaxScratchBufferSize);
+            if (scratch == null || scratch.Length < scratchSize)
+            {
+                scratch = new byte[scratchSize];
+                scratchBuffer = scratch;
+            }
+
+            int total = 0;
+            while (total < count)
             {
-                var bufferStream = new MemoryStream(buffer);
-                long prevPosition = BodyStream.Position;
-                CRT.CopyStream(BodyStream, bufferStream, (int)size);
-                bytesWritten = (ulong)(BodyStream.Position - prevPosition);
-                if (BodyStream.Position != BodyStream.Length)
+                int read = BodyStream.Read(scratch, 0, Math.Min(count - total, scratch.Length));
+                if (read == 0)
                 {
-                    return (int) StreamState.InProgress;
+                    endOfStream = true;
+                    break;
                 }
+
+                Marshal.Copy(scratch, 0, new IntPtr(buffer.ToInt64() + total), read);
+                total += read;
             }
 
-            return (int) StreamState.Done;
+            return total;
         }
 
-        public CrtStreamWrapper(Stream stream)
+        private void AsyncReadInternal(IntPtr stream, IntPtr buffer, ulong size) {
+            int count = (int)Math.Min(size, (ulong)MaxScratchBufferSize);
+            if (asyncReadBuffer == null || asyncReadBuffer.Length < count)
+            {
+                asyncReadBuffer = new byte[count];
+            }
+            byte[] readBuffer = asyncReadBuffer;
+
+            try
+            {
+#if BCL35
+                BodyStream.BeginRead(readBuffer, 0, count, (result) => {
+                    int read = -1;
+                    try
+                    {
+                        read = BodyStream.EndRead(result);
+                    }
+                    catch (Exception)
+                    {
+                        ;
+                    }
+                    CompleteAsyncRead(stream, buffer, readBuffer, read);
+                }, null);
+#else
+                BodyStream.ReadAsync(readBuffer, 0, count).ContinueWith((task) => {
+                    int read = task.Status == TaskStatus.RanToCompletion ? task.Result : -1;
+                    CompleteAsyncRead(stream, buffer, readBuffer, read);
+                }, TaskContinuationOptions.ExecuteSynchronously);
+#endif
+            }
+            catch (Exception)
+            {
+                CompleteAsyncRead(stream, buffer, readBuffer, -1);
+            }
+        }
+
+        // read is the number of bytes read into readBuffer, or -1 if the read failed
+        private static void CompleteAsyncRead(IntPtr stream, IntPtr buffer, byte[] readBuffer, int read) {
+            if (read < 0)
+            {
+                API.complete_read(stream, 0, false, true);
+                return;
+            }
+
+            Marshal.Copy(readBuffer, 0, buffer, read);
+            API.complete_read(stream, (ulong)read, read == 0, false);
+        }
+
+        private bool GetLengthInternal(out long length) {
+            length = 0;
+            try {
+                if (BodyStream.CanSeek) {
+                    length = BodyStream.Length;
+                    return true;
+                }
+            } catch (NotSupportedException) {
+                ;
+            }
+
+            return false;
+        }
+
+        public CrtStreamWrapper(Stream stream) : this(stream, null)
+        {
+        }
+
+        public CrtStreamWrapper(Stream stream, CrtFileBody file) : this(stream, file, false)
+        {
+        }
+
+        /*
+         * A body is either a managed stream or a file, so at most one of stream and file may be set.  With asyncReads,
+         * native code reads the stream with ReadAsync (BeginRead on .NET 3.5) and never waits for a read to finish, but
+         * can't seek it.
+         */
+        public CrtStreamWrapper(Stream stream, CrtFileBody file, bool asyncReads)
         {
+            if (stream != null && file != null) {
+                throw new ArgumentException("A body can't be both a stream and a file", "file");
+            }
+
             BodyStream = stream;
             var delegates = new DelegateTable();
 
             /*
-             * We pass the delegate table by value to C, so we indicate a null stream with a nulled table.
+             * We pass the delegate table by value to C, so we indicate a null stream with a nulled table (and no file).
              */
             if (stream != null) {
                 delegates.ReadCallback = ReadInternal;
                 delegates.SeekCallback = SeekInternal;
+                delegates.GetLengthCallback = GetLengthInternal;
+                delegates.AsyncReadCallback = asyncReads ? AsyncReadInternal : (CrtStreamAsyncReadCallback)null;
             } else {
                 delegates.ReadCallback = null;
                 delegates.SeekCallback = null;
+                delegates.GetLengthCallback = null;
+                delegates.AsyncReadCallback = null;
+            }
+
+            if (file != null) {
+                filePath = new FilePathHandle(file.Path);
+                delegates.FilePath = filePath.DangerousGetHandle();
+                delegates.FileOffset = file.Offset;
+                delegates.FileLength = file.Length;
             }
 
             Delegates = delegates;
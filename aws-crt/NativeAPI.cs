@@ -138,16 +138,26 @@ namespace Aws.Crt {
         public delegate TResult CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16, TResult>(T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6, T7 arg7, T8 arg8, T9 arg9, T10 arg10, T11 arg11, T12 arg12, T13 arg13, T14 arg14, T15 arg15, T16 arg16);
 
 
+        // Binds a strongly typed CrtAction/CrtFunc to the Invoke method of the native delegate. Calling
+        // through it keeps the marshalling attributes of the native delegate type, but avoids the boxing,
+        // argument array allocation and reflection dispatch of Delegate.DynamicInvoke
+        private static T Direct<T>(Delegate d) where T : class
+        {
+            return Delegate.CreateDelegate(typeof(T), d, "Invoke") as T;
+        }
+
         #region MakeCall/MakeVoidCall specializations
         public static Delegate MakeVoidCall(Delegate d) {
+            var native = Direct<CrtAction>(d);
             return new CrtAction(() => {
-                d.DynamicInvoke(null);
+                native();
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<R>(Delegate d) {
+            var native = Direct<CrtFunc<R>>(d);
             return new CrtFunc<R>(() => {
-                R res = (R)d.DynamicInvoke(null);
+                R res = native();
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -155,31 +165,35 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1>(Delegate d)
         {
+            var native = Direct<CrtAction<T1>>(d);
             return new CrtAction<T1>((a1) =>
             {
-                d.DynamicInvoke(new object[] { a1 });
+                native(a1);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, R>>(d);
             return new CrtFunc<T1, R>((a1) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1 });
+                R res = native(a1);
                 NativeException.CheckNativeException();
                 return res;
             });
         }
 
         public static Delegate MakeVoidCall<T1, T2>(Delegate d) {
+            var native = Direct<CrtAction<T1, T2>>(d);
             return new CrtAction<T1, T2>((a1, a2) => {
-                d.DynamicInvoke(new object[] { a1, a2 });
+                native(a1, a2);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, R>(Delegate d) {
+            var native = Direct<CrtFunc<T1, T2, R>>(d);
             return new CrtFunc<T1, T2, R>((a1, a2) => {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2 });
+                R res = native(a1, a2);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -187,17 +201,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3>>(d);
             return new CrtAction<T1, T2, T3>((a1, a2, a3) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3 });
+                native(a1, a2, a3);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, R>>(d);
             return new CrtFunc<T1, T2, T3, R>((a1, a2, a3) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3 });
+                R res = native(a1, a2, a3);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -205,17 +221,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4>>(d);
             return new CrtAction<T1, T2, T3, T4>((a1, a2, a3, a4) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4 });
+                native(a1, a2, a3, a4);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, R>((a1, a2, a3, a4) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4 });
+                R res = native(a1, a2, a3, a4);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -223,17 +241,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5>>(d);
             return new CrtAction<T1, T2, T3, T4, T5>((a1, a2, a3, a4, a5) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5 });
+                native(a1, a2, a3, a4, a5);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, R>((a1, a2, a3, a4, a5) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5 });
+                R res = native(a1, a2, a3, a4, a5);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -241,17 +261,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6>((a1, a2, a3, a4, a5, a6) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6 });
+                native(a1, a2, a3, a4, a5, a6);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, R>((a1, a2, a3, a4, a5, a6) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6 });
+                R res = native(a1, a2, a3, a4, a5, a6);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -259,17 +281,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7>((a1, a2, a3, a4, a5, a6, a7) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7 });
+                native(a1, a2, a3, a4, a5, a6, a7);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, R>((a1, a2, a3, a4, a5, a6, a7) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -277,17 +301,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8>((a1, a2, a3, a4, a5, a6, a7, a8) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, R>((a1, a2, a3, a4, a5, a6, a7, a8) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -295,17 +321,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9>((a1, a2, a3, a4, a5, a6, a7, a8, a9) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -313,17 +341,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -331,17 +361,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -349,17 +381,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -367,17 +401,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -385,17 +421,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -403,17 +441,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
                 NativeException.CheckNativeException();
                 return res;
             });
@@ -421,17 +461,19 @@ namespace Aws.Crt {
 
         public static Delegate MakeVoidCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>(Delegate d)
         {
+            var native = Direct<CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>>(d);
             return new CrtAction<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16) =>
             {
-                d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16 });
+                native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
                 NativeException.CheckNativeException();
             });
         }
         public static Delegate MakeCall<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16, R>(Delegate d)
         {
+            var native = Direct<CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16, R>>(d);
             return new CrtFunc<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16, R>((a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16) =>
             {
-                R res = (R)d.DynamicInvoke(new object[] { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16 });
+                R res = native(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
                 NativeException.CheckNativeException();
                 return res;
             });
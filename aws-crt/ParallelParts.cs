@@ -0,0 +1,59 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Threading;
+
+namespace Aws.Crt
+{
+    /*
+     * Splits CPU bound native work, such as checksumming or verifying a large batch, across threads.  It isn't public
+     * API, so the assemblies that need it compile this file in as well.
+     */
+    internal static class ParallelParts
+    {
+        // Runs runPart(i) for every part in [0, parts), all but the first on new threads, and rethrows the first failure
+        // once every part has finished
+        public static void Run(int parts, Action<int> runPart)
+        {
+            var threads = new Thread[parts];
+            Exception failure = null;
+            for (int i = 1; i < parts; ++i)
+            {
+                int part = i;
+                threads[i] = new Thread(() => {
+                    try
+                    {
+                        runPart(part);
+                    }
+                    catch (Exception ex)
+                    {
+                        Interlocked.CompareExchange(ref failure, ex, null);
+                    }
+                });
+                threads[i].IsBackground = true;
+                threads[i].Start();
+            }
+
+            try
+            {
+                runPart(0);
+            }
+            catch (Exception ex)
+            {
+                Interlocked.CompareExchange(ref failure, ex, null);
+            }
+
+            for (int i = 1; i < parts; ++i)
+            {
+                threads[i].Join();
+            }
+
+            if (failure != null)
+            {
+                throw failure;
+            }
+        }
+    }
+}
@@ -0,0 +1,269 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "crt.h"
+#include "exports.h"
+#include "stream.h"
+
+#include <aws/http/connection.h>
+#include <aws/http/request_response.h>
+#include <aws/io/async_stream.h>
+#include <aws/io/future.h>
+#include <aws/io/stream.h>
+
+/*
+ * An async input stream whose reads are fulfilled by managed code, which starts a Stream.ReadAsync and later calls
+ * aws_dotnet_async_input_stream_complete_read. Only one read is outstanding at a time.
+ */
+struct aws_dotnet_async_input_stream {
+    struct aws_async_input_stream base;
+
+    aws_dotnet_stream_async_read_fn *read;
+
+    /* The outstanding read, if any */
+    struct aws_byte_buf *dest;
+    struct aws_future_bool *pending;
+};
+
+static void s_async_input_stream_destroy(struct aws_async_input_stream *stream) {
+    struct aws_dotnet_async_input_stream *impl = stream->impl;
+    aws_mem_release(stream->alloc, impl);
+}
+
+static struct aws_future_bool *s_async_input_stream_read(
+    struct aws_async_input_stream *stream,
+    struct aws_byte_buf *dest) {
+
+    struct aws_dotnet_async_input_stream *impl = stream->impl;
+    struct aws_future_bool *future = aws_future_bool_new(stream->alloc);
+
+    /* Managed code holds the stream until it completes the read, which may happen before this returns */
+    impl->dest = dest;
+    impl->pending = aws_future_bool_acquire(future);
+    aws_async_input_stream_acquire(stream);
+
+    impl->read(stream, dest->buffer + dest->len, dest->capacity - dest->len);
+
+    return future;
+}
+
+static const struct aws_async_input_stream_vtable s_async_input_stream_vtable = {
+    .destroy = s_async_input_stream_destroy,
+    .read = s_async_input_stream_read,
+};
+
+static struct aws_async_input_stream *s_async_input_stream_new_dotnet(
+    struct aws_allocator *allocator,
+    aws_dotnet_stream_async_read_fn *read) {
+
+    struct aws_dotnet_async_input_stream *impl =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_async_input_stream));
+
+    aws_async_input_stream_init_base(&impl->base, allocator, &s_async_input_stream_vtable, impl);
+    impl->read = read;
+
+    return &impl->base;
+}
+
+/* Called by managed code, on any thread, when the read started by the read callback finishes */
+AWS_DOTNET_API
+void aws_dotnet_async_input_stream_complete_read(
+    struct aws_async_input_stream *stream,
+    uint64_t bytes_read,
+    bool end_of_stream,
+    bool failed) {
+
+    struct aws_dotnet_async_input_stream *impl = stream->impl;
+    struct aws_future_bool *future = impl->pending;
+    struct aws_byte_buf *dest = impl->dest;
+    AWS_FATAL_ASSERT(future != NULL && "Async body read completed with no read outstanding");
+
+    impl->pending = NULL;
+    impl->dest = NULL;
+
+    if (failed) {
+        aws_future_bool_set_error(future, AWS_IO_STREAM_READ_FAILED);
+    } else {
+        AWS_FATAL_ASSERT(
+            bytes_read <= dest->capacity - dest->len && "Buffer overflow detected streaming outgoing body");
+        dest->len += (size_t)bytes_read;
+        aws_future_bool_set_result(future, end_of_stream);
+    }
+
+    aws_future_bool_release(future);
+    aws_async_input_stream_release(stream);
+}
+
+/*
+ * Sends a request body read with async reads by pushing each read to the stream as soon as it finishes, as an HTTP/1.1
+ * chunk or an HTTP/2 DATA frame. A body set on the request would be pulled by the connection, and aws_input_stream
+ * has no way to signal that data has become available, so the connection would poll it while a read is in flight.
+ *
+ * Reads and writes alternate, with one of them in flight at a time, which holds a reference to the body.
+ */
+struct aws_dotnet_async_body {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+
+    struct aws_async_input_stream *source;
+    struct aws_future_bool *pending_read;
+
+    /* Data from the last async read, which is written before the next read starts */
+    struct aws_byte_buf buffer;
+    bool end_of_stream;
+
+    /* Set when sending starts, after which the body owns this reference to the stream */
+    struct aws_http_stream *stream;
+    enum aws_http_version version;
+
+    /* The data of the write in flight, over buffer, and whether that write ends the body */
+    struct aws_input_stream *data;
+    bool last_write;
+};
+
+static void s_async_body_destroy(void *user_data) {
+    struct aws_dotnet_async_body *body = user_data;
+
+    aws_http_stream_release(body->stream);
+    aws_async_input_stream_release(body->source);
+    aws_byte_buf_clean_up(&body->buffer);
+    aws_mem_release(body->allocator, body);
+}
+
+/* Stops sending, failing the request, which can't complete without the rest of its body */
+static void s_async_body_fail(struct aws_dotnet_async_body *body, int error_code) {
+    aws_http_stream_cancel(body->stream, error_code);
+    aws_ref_count_release(&body->ref_count);
+}
+
+static void s_async_body_read_next(struct aws_dotnet_async_body *body);
+static void s_async_body_write(struct aws_dotnet_async_body *body);
+
+static void s_async_body_on_write_complete(struct aws_http_stream *stream, int error_code, void *user_data) {
+    (void)stream;
+    struct aws_dotnet_async_body *body = user_data;
+
+    aws_input_stream_release(body->data);
+    body->data = NULL;
+
+    if (error_code != AWS_ERROR_SUCCESS) {
+        s_async_body_fail(body, error_code);
+    } else if (body->last_write) {
+        aws_ref_count_release(&body->ref_count);
+    } else if (body->end_of_stream) {
+        /* The last read's data went out in a chunk of its own, and HTTP/1.1 ends the body with an empty chunk */
+        body->buffer.len = 0;
+        s_async_body_write(body);
+    } else {
+        s_async_body_read_next(body);
+    }
+}
+
+/* Writes the data of the last read, which may be empty once the body has ended */
+static void s_async_body_write(struct aws_dotnet_async_body *body) {
+    struct aws_byte_cursor data = aws_byte_cursor_from_buf(&body->buffer);
+    if (data.len > 0) {
+        body->data = aws_input_stream_new_from_cursor(body->allocator, &data);
+        if (body->data == NULL) {
+            s_async_body_fail(body, aws_last_error());
+            return;
+        }
+    }
+
+    int result = AWS_OP_SUCCESS;
+    if (body->version == AWS_HTTP_VERSION_2) {
+        body->last_write = body->end_of_stream;
+
+        struct aws_http2_stream_write_data_options options;
+        AWS_ZERO_STRUCT(options);
+        options.data = body->data;
+        options.end_stream = body->end_of_stream;
+        options.on_complete = s_async_body_on_write_complete;
+        options.user_data = body;
+        result = aws_http2_stream_write_data(body->stream, &options);
+    } else {
+        body->last_write = data.len == 0;
+
+        struct aws_http1_chunk_options options;
+        AWS_ZERO_STRUCT(options);
+        options.chunk_data = body->data;
+        options.chunk_data_size = data.len;
+        options.on_complete = s_async_body_on_write_complete;
+        options.user_data = body;
+        result = aws_http1_stream_write_chunk(body->stream, &options);
+    }
+
+    if (result != AWS_OP_SUCCESS) {
+        aws_input_stream_release(body->data);
+        body->data = NULL;
+        s_async_body_fail(body, aws_last_error());
+    }
+}
+
+static void s_async_body_on_read_done(void *user_data) {
+    struct aws_dotnet_async_body *body = user_data;
+
+    struct aws_future_bool *read = body->pending_read;
+    body->pending_read = NULL;
+
+    int error_code = aws_future_bool_get_error(read);
+    if (error_code == AWS_ERROR_SUCCESS) {
+        body->end_of_stream = aws_future_bool_get_result(read);
+    }
+    aws_future_bool_release(read);
+
+    if (error_code != AWS_ERROR_SUCCESS) {
+        s_async_body_fail(body, error_code);
+    } else if (body->buffer.len == 0 && !body->end_of_stream) {
+        s_async_body_read_next(body);
+    } else {
+        s_async_body_write(body);
+    }
+}
+
+static void s_async_body_read_next(struct aws_dotnet_async_body *body) {
+    body->buffer.len = 0;
+
+    body->pending_read = aws_async_input_stream_read(body->source, &body->buffer);
+    if (!aws_future_bool_register_callback_if_not_done(body->pending_read, s_async_body_on_read_done, body)) {
+        s_async_body_on_read_done(body);
+    }
+}
+
+struct aws_dotnet_async_body *aws_dotnet_async_body_new(
+    struct aws_allocator *allocator,
+    struct aws_dotnet_stream_function_table *function_table) {
+
+    struct aws_dotnet_async_body *body = aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_async_body));
+    body->allocator = allocator;
+
+    if (aws_byte_buf_init(&body->buffer, allocator, AWS_DOTNET_ASYNC_STREAM_BUFFER_SIZE)) {
+        aws_mem_release(allocator, body);
+        return NULL;
+    }
+
+    body->source = s_async_input_stream_new_dotnet(allocator, function_table->async_read);
+    aws_ref_count_init(&body->ref_count, body, s_async_body_destroy);
+
+    return body;
+}
+
+void aws_dotnet_async_body_start(struct aws_dotnet_async_body *body, struct aws_http_stream *stream) {
+    body->stream = stream;
+    body->version = aws_http_connection_get_version(aws_http_stream_get_connection(stream));
+
+    aws_ref_count_acquire(&body->ref_count);
+    s_async_body_read_next(body);
+}
+
+bool aws_dotnet_async_body_is_sending(struct aws_dotnet_async_body *body) {
+    return body->stream != NULL;
+}
+
+void aws_dotnet_async_body_release(struct aws_dotnet_async_body *body) {
+    if (body != NULL) {
+        aws_ref_count_release(&body->ref_count);
+    }
+}
@@ -4,7 +4,9 @@
  */
 
 #include "crt.h"
+#include "ecc_key_cache.h"
 #include "exports.h"
+#include "signing_key_cache.h"
 
 #include <aws/auth/auth.h>
 
@@ -18,5 +20,7 @@ void aws_dotnet_auth_library_init(void) {
 
 AWS_DOTNET_API
 void aws_dotnet_auth_library_clean_up(void) {
+    aws_dotnet_signing_key_cache_clean_up();
+    aws_dotnet_ecc_key_cache_clean_up();
     aws_auth_library_clean_up();
 }
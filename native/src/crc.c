@@ -6,18 +6,198 @@
 #include "aws/checksums/crc.h"
 #include "crt.h"
 #include "exports.h"
+#include "file_mapping.h"
+
+#include <inttypes.h>
+
+/* length comes from managed code as 64 bits, which may not fit in a 32-bit platform's size_t */
+static bool s_length_fits(uint64_t length) {
+#if SIZE_MAX < UINT64_MAX
+    if (length > SIZE_MAX) {
+        aws_dotnet_throw_exception(AWS_ERROR_INVALID_ARGUMENT, "Length %" PRIu64 " is too large for this platform", length);
+        return false;
+    }
+#else
+    (void)length;
+#endif
+    return true;
+}
 
 AWS_DOTNET_API
-uint32_t aws_dotnet_crc32(const uint8_t *input, int length, uint32_t previous) {
+uint32_t aws_dotnet_crc32(const uint8_t *input, uint64_t length, uint32_t previous) {
+    if (!s_length_fits(length)) {
+        return previous;
+    }
     return aws_checksums_crc32_ex(input, (size_t)length, previous);
 }
 
 AWS_DOTNET_API
-uint32_t aws_dotnet_crc32c(const uint8_t *input, int length, uint32_t previous) {
+uint32_t aws_dotnet_crc32c(const uint8_t *input, uint64_t length, uint32_t previous) {
+    if (!s_length_fits(length)) {
+        return previous;
+    }
     return aws_checksums_crc32c_ex(input, (size_t)length, previous);
 }
 
 AWS_DOTNET_API
-uint64_t aws_dotnet_crc64nvme(const uint8_t *input, int length, uint64_t previous) {
+uint64_t aws_dotnet_crc64nvme(const uint8_t *input, uint64_t length, uint64_t previous) {
+    if (!s_length_fits(length)) {
+        return previous;
+    }
     return aws_checksums_crc64nvme_ex(input, (size_t)length, previous);
 }
+
+/* Reflected polynomials of the supported CRCs */
+#define AWS_DOTNET_CRC32_POLY 0xEDB88320ULL
+#define AWS_DOTNET_CRC32C_POLY 0x82F63B78ULL
+#define AWS_DOTNET_CRC64NVME_POLY 0x9A6C9329AC4BC9B5ULL
+
+/*
+ * a * b mod poly over GF(2), for a reflected CRC of the given width, where x^0 is the most significant bit.
+ * Same approach as multmodp() in zlib's crc32.c.
+ */
+static uint64_t s_crc_multiply_mod_poly(uint64_t a, uint64_t b, uint64_t poly, int width) {
+    uint64_t m = (uint64_t)1 << (width - 1);
+    uint64_t p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+    }
+    return p;
+}
+
+/*
+ * Given crc1 of A and crc2 of B, returns the crc of A followed by B: crc1 shifted over len2 zero bytes, which is a
+ * multiplication by x^(8 * len2) mod poly, xor crc2. x^(8 * len2) is built from repeated squares of x^8.
+ */
+static uint64_t s_crc_combine(uint64_t crc1, uint64_t crc2, uint64_t len2, uint64_t poly, int width) {
+    uint64_t x_pow = (uint64_t)1 << (width - 1);
+    uint64_t x_pow_8_2n = (uint64_t)1 << (width - 1 - 8);
+    while (len2 != 0) {
+        if (len2 & 1) {
+            x_pow = s_crc_multiply_mod_poly(x_pow_8_2n, x_pow, poly, width);
+        }
+        len2 >>= 1;
+        if (len2 != 0) {
+            x_pow_8_2n = s_crc_multiply_mod_poly(x_pow_8_2n, x_pow_8_2n, poly, width);
+        }
+    }
+    return s_crc_multiply_mod_poly(x_pow, crc1, poly, width) ^ crc2;
+}
+
+AWS_DOTNET_API
+uint32_t aws_dotnet_crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t length2) {
+    return (uint32_t)s_crc_combine(crc1, crc2, length2, AWS_DOTNET_CRC32_POLY, 32);
+}
+
+AWS_DOTNET_API
+uint32_t aws_dotnet_crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t length2) {
+    return (uint32_t)s_crc_combine(crc1, crc2, length2, AWS_DOTNET_CRC32C_POLY, 32);
+}
+
+AWS_DOTNET_API
+uint64_t aws_dotnet_crc64nvme_combine(uint64_t crc1, uint64_t crc2, uint64_t length2) {
+    return s_crc_combine(crc1, crc2, length2, AWS_DOTNET_CRC64NVME_POLY, 64);
+}
+
+/* Must match Aws.Crt.Checksums.CrcAlgorithms */
+enum aws_dotnet_crc_algorithm {
+    AWS_DOTNET_CRC32 = 1,
+    AWS_DOTNET_CRC32C = 2,
+    AWS_DOTNET_CRC64NVME = 4,
+};
+
+/* Indices into the results of aws_dotnet_crc_file */
+enum aws_dotnet_crc_result {
+    AWS_DOTNET_CRC_RESULT_CRC32,
+    AWS_DOTNET_CRC_RESULT_CRC32C,
+    AWS_DOTNET_CRC_RESULT_CRC64NVME,
+    AWS_DOTNET_CRC_RESULT_COUNT,
+};
+
+struct crc_file_state {
+    uint32_t algorithms;
+    uint32_t crc32;
+    uint32_t crc32c;
+    uint64_t crc64nvme;
+};
+
+static int s_crc_file_region(struct aws_byte_cursor region, void *user_data) {
+    struct crc_file_state *state = user_data;
+    if (state->algorithms & AWS_DOTNET_CRC32) {
+        state->crc32 = aws_checksums_crc32_ex(region.ptr, region.len, state->crc32);
+    }
+    if (state->algorithms & AWS_DOTNET_CRC32C) {
+        state->crc32c = aws_checksums_crc32c_ex(region.ptr, region.len, state->crc32c);
+    }
+    if (state->algorithms & AWS_DOTNET_CRC64NVME) {
+        state->crc64nvme = aws_checksums_crc64nvme_ex(region.ptr, region.len, state->crc64nvme);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Computes each of the requested algorithms over [offset, offset + length) of a file in a single pass over a
+ * memory mapping of it. results must have room for AWS_DOTNET_CRC_RESULT_COUNT values.
+ */
+AWS_DOTNET_API
+void aws_dotnet_crc_file(const char *path, uint64_t offset, uint64_t length, uint32_t algorithms, uint64_t *results) {
+    struct crc_file_state state;
+    AWS_ZERO_STRUCT(state);
+    state.algorithms = algorithms;
+
+    if (aws_dotnet_file_for_each_region(path, offset, length, s_crc_file_region, &state)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to checksum file %s", path);
+        return;
+    }
+
+    results[AWS_DOTNET_CRC_RESULT_CRC32] = state.crc32;
+    results[AWS_DOTNET_CRC_RESULT_CRC32C] = state.crc32c;
+    results[AWS_DOTNET_CRC_RESULT_CRC64NVME] = state.crc64nvme;
+}
+
+/*
+ * Batch variants checksum count independent records of buffer in one call: record i is
+ * [offsets[i], offsets[i] + lengths[i]), and its CRC is written to results[i]
+ */
+AWS_DOTNET_API
+void aws_dotnet_crc32_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint32_t *results) {
+    for (uint32_t i = 0; i < count; ++i) {
+        results[i] = aws_checksums_crc32_ex(buffer + offsets[i], (size_t)lengths[i], 0);
+    }
+}
+
+AWS_DOTNET_API
+void aws_dotnet_crc32c_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint32_t *results) {
+    for (uint32_t i = 0; i < count; ++i) {
+        results[i] = aws_checksums_crc32c_ex(buffer + offsets[i], (size_t)lengths[i], 0);
+    }
+}
+
+AWS_DOTNET_API
+void aws_dotnet_crc64nvme_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint64_t *results) {
+    for (uint32_t i = 0; i < count; ++i) {
+        results[i] = aws_checksums_crc64nvme_ex(buffer + offsets[i], (size_t)lengths[i], 0);
+    }
+}
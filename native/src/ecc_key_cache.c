@@ -0,0 +1,83 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "ecc_key_cache.h"
+#include "crt.h"
+#include "exports.h"
+#include "keyed_cache.h"
+
+#include <aws/auth/credentials.h>
+#include <aws/cal/ecc.h>
+#include <aws/cal/hash.h>
+
+static void s_destroy_key_pair(void *key_pair) {
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/* Digest of access key and secret -> aws_ecc_key_pair, created on first use */
+static struct aws_dotnet_keyed_cache s_cache =
+    AWS_DOTNET_KEYED_CACHE_INIT(AWS_DOTNET_ECC_KEY_CACHE_CAPACITY, s_destroy_key_pair);
+
+static void s_acquire_key_pair(void *cached, void *key_pair) {
+    aws_ecc_key_pair_acquire(cached);
+    *(struct aws_ecc_key_pair **)key_pair = cached;
+}
+
+struct aws_credentials *aws_dotnet_ecc_key_cache_get_credentials(const struct aws_credentials *credentials) {
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_byte_cursor identity[] = {
+        aws_credentials_get_access_key_id(credentials),
+        aws_credentials_get_secret_access_key(credentials),
+    };
+    uint8_t digest_storage[AWS_SHA256_LEN];
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    if (aws_dotnet_keyed_cache_digest(identity, AWS_ARRAY_SIZE(identity), &digest)) {
+        return NULL;
+    }
+
+    struct aws_byte_cursor digest_cursor = aws_byte_cursor_from_buf(&digest);
+    struct aws_ecc_key_pair *key_pair = NULL;
+    if (aws_dotnet_keyed_cache_find(&s_cache, digest_cursor, s_acquire_key_pair, &key_pair)) {
+        struct aws_credentials *ecc_credentials = aws_credentials_new_ecc(
+            allocator,
+            aws_credentials_get_access_key_id(credentials),
+            key_pair,
+            aws_credentials_get_session_token(credentials),
+            aws_credentials_get_expiration_timepoint_seconds(credentials));
+        aws_ecc_key_pair_release(key_pair);
+        return ecc_credentials;
+    }
+
+    /* derive outside the lock, a concurrent miss for the same credentials just replaces an identical key */
+    struct aws_credentials *ecc_credentials = aws_credentials_new_ecc_from_aws_credentials(allocator, credentials);
+    if (ecc_credentials == NULL) {
+        return NULL;
+    }
+
+    key_pair = aws_credentials_get_ecc_key_pair(ecc_credentials);
+    aws_ecc_key_pair_acquire(key_pair);
+    if (!aws_dotnet_keyed_cache_put(&s_cache, digest_cursor, key_pair)) {
+        aws_ecc_key_pair_release(key_pair);
+    }
+
+    return ecc_credentials;
+}
+
+/* stats has room for AWS_DOTNET_KEYED_CACHE_STAT_COUNT values */
+AWS_DOTNET_API
+void aws_dotnet_auth_ecc_key_cache_get_stats(uint64_t *stats) {
+    aws_dotnet_keyed_cache_get_stats(&s_cache, stats);
+}
+
+/* Drops every cached key pair and resets the counters */
+AWS_DOTNET_API
+void aws_dotnet_auth_ecc_key_cache_clear(void) {
+    aws_dotnet_keyed_cache_configure(&s_cache, 0);
+}
+
+void aws_dotnet_ecc_key_cache_clean_up(void) {
+    aws_dotnet_auth_ecc_key_cache_clear();
+}
@@ -0,0 +1,25 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_DOTNET_ECC_KEY_CACHE_H
+#define AWS_DOTNET_ECC_KEY_CACHE_H
+
+#include <aws/common/common.h>
+
+struct aws_credentials;
+
+#define AWS_DOTNET_ECC_KEY_CACHE_CAPACITY 64
+
+/*
+ * Process wide, bounded LRU cache of SigV4a ECC key pairs derived from an access key and secret, so that signing with
+ * the same credentials again doesn't repeat the derivation.
+ *
+ * Returns credentials carrying the ECC key pair for credentials, or NULL on failure. The caller releases them.
+ */
+struct aws_credentials *aws_dotnet_ecc_key_cache_get_credentials(const struct aws_credentials *credentials);
+
+void aws_dotnet_ecc_key_cache_clean_up(void);
+
+#endif /* AWS_DOTNET_ECC_KEY_CACHE_H */
@@ -0,0 +1,214 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#if !defined(_WIN32)
+/* 64 bit file offsets on 32 bit linux */
+#    define _FILE_OFFSET_BITS 64
+#endif
+
+#include "file_mapping.h"
+#include "crt.h"
+
+#include <aws/common/file.h>
+#include <aws/io/io.h>
+
+#if defined(_WIN32)
+#    include <windows.h>
+#else
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+static int s_resolve_range(uint64_t file_size, uint64_t offset, uint64_t *length) {
+    if (offset > file_size) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (*length == AWS_DOTNET_FILE_MAPPING_TO_END) {
+        *length = file_size - offset;
+    } else if (*length > file_size - offset) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+#if defined(_WIN32)
+
+/* paths arrive from managed code as UTF-8, which the ANSI (A) file APIs would read in the system code page */
+static HANDLE s_open_file_utf8(const char *path) {
+    int wide_length = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, path, -1, NULL, 0);
+    if (wide_length <= 0) {
+        aws_raise_error(AWS_ERROR_FILE_INVALID_PATH);
+        return INVALID_HANDLE_VALUE;
+    }
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+    wchar_t *wide_path = aws_mem_acquire(allocator, (size_t)wide_length * sizeof(wchar_t));
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, path, -1, wide_path, wide_length) != wide_length) {
+        aws_raise_error(AWS_ERROR_FILE_INVALID_PATH);
+        goto done;
+    }
+
+    file = CreateFileW(
+        wide_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        aws_raise_error(AWS_ERROR_FILE_INVALID_PATH);
+    }
+
+done:
+    aws_mem_release(allocator, wide_path);
+    return file;
+}
+
+int aws_dotnet_file_for_each_region(
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    aws_dotnet_file_region_fn *on_region,
+    void *user_data) {
+
+    int result = AWS_OP_ERR;
+    HANDLE mapping = NULL;
+    HANDLE file = s_open_file_utf8(path);
+    if (file == INVALID_HANDLE_VALUE) {
+        return AWS_OP_ERR;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+        goto done;
+    }
+
+    if (s_resolve_range((uint64_t)file_size.QuadPart, offset, &length)) {
+        goto done;
+    }
+
+    if (length == 0) {
+        /* empty files can't be mapped */
+        result = AWS_OP_SUCCESS;
+        goto done;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+        goto done;
+    }
+
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    uint64_t granularity = system_info.dwAllocationGranularity;
+
+    while (length > 0) {
+        uint64_t map_offset = offset - offset % granularity;
+        size_t lead = (size_t)(offset - map_offset);
+        size_t window = (size_t)aws_min_u64(length, AWS_DOTNET_FILE_MAPPING_WINDOW_SIZE);
+
+        uint8_t *view = MapViewOfFile(
+            mapping, FILE_MAP_READ, (DWORD)(map_offset >> 32), (DWORD)(map_offset & 0xFFFFFFFF), lead + window);
+        if (view == NULL) {
+            aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+            goto done;
+        }
+
+        int region_result = on_region(aws_byte_cursor_from_array(view + lead, window), user_data);
+        UnmapViewOfFile(view);
+        if (region_result) {
+            goto done;
+        }
+
+        offset += window;
+        length -= window;
+    }
+
+    result = AWS_OP_SUCCESS;
+
+done:
+    if (mapping != NULL) {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+
+    return result;
+}
+
+#else
+
+int aws_dotnet_file_for_each_region(
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    aws_dotnet_file_region_fn *on_region,
+    void *user_data) {
+
+    int result = AWS_OP_ERR;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return aws_translate_and_raise_io_error(errno);
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat)) {
+        aws_translate_and_raise_io_error(errno);
+        goto done;
+    }
+
+    if (s_resolve_range((uint64_t)file_stat.st_size, offset, &length)) {
+        goto done;
+    }
+
+    uint64_t page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+
+    while (length > 0) {
+        uint64_t map_offset = offset - offset % page_size;
+        size_t lead = (size_t)(offset - map_offset);
+        size_t window = (size_t)aws_min_u64(length, AWS_DOTNET_FILE_MAPPING_WINDOW_SIZE);
+
+        /*
+         * Reading a mapped page beyond the end of the file raises SIGBUS, so a file truncated since it was opened
+         * fails here instead, as reading it would have hit the end of the stream. This can't catch truncation while
+         * a window is being read.
+         */
+        if (fstat(fd, &file_stat)) {
+            aws_translate_and_raise_io_error(errno);
+            goto done;
+        }
+        if ((uint64_t)file_stat.st_size < offset + window) {
+            aws_raise_error(AWS_IO_STREAM_READ_FAILED);
+            goto done;
+        }
+
+        void *view = mmap(NULL, lead + window, PROT_READ, MAP_PRIVATE, fd, (off_t)map_offset);
+        if (view == MAP_FAILED) {
+            aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+            goto done;
+        }
+        posix_madvise(view, lead + window, POSIX_MADV_SEQUENTIAL);
+
+        int region_result = on_region(aws_byte_cursor_from_array((uint8_t *)view + lead, window), user_data);
+        munmap(view, lead + window);
+        if (region_result) {
+            goto done;
+        }
+
+        offset += window;
+        length -= window;
+    }
+
+    result = AWS_OP_SUCCESS;
+
+done:
+    close(fd);
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_DOTNET_FILE_MAPPING_H
+#define AWS_DOTNET_FILE_MAPPING_H
+
+#include <aws/common/byte_buf.h>
+
+/* Files are mapped at most this many bytes at a time, which bounds address space use on 32 bit processes */
+#define AWS_DOTNET_FILE_MAPPING_WINDOW_SIZE (64 * 1024 * 1024)
+
+/* Passed as length to read to the end of the file */
+#define AWS_DOTNET_FILE_MAPPING_TO_END UINT64_MAX
+
+typedef int(aws_dotnet_file_region_fn)(struct aws_byte_cursor region, void *user_data);
+
+/*
+ * Memory maps [offset, offset + length) of the file at the UTF-8 path one window at a time, with a sequential access
+ * hint, and calls on_region with each window in order. The region is only valid for the duration of the callback.
+ * Raises an error and returns AWS_OP_ERR if the file can't be opened or mapped, the range is not within the file,
+ * the file is truncated before the range is read, or on_region returns AWS_OP_ERR.
+ *
+ * Windows keeps other processes from writing the file while it is open. Elsewhere, truncating the file while a
+ * window is mapped and being read kills the process with SIGBUS, so files that may be shrunk concurrently must be
+ * read through a stream instead.
+ */
+int aws_dotnet_file_for_each_region(
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    aws_dotnet_file_region_fn *on_region,
+    void *user_data);
+
+#endif /* AWS_DOTNET_FILE_MAPPING_H */
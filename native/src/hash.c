@@ -4,46 +4,325 @@
  */
 
 #include "aws/cal/hash.h"
+#include "aws/checksums/crc.h"
 #include "crt.h"
 #include "exports.h"
+#include "file_mapping.h"
 
-AWS_DOTNET_API
-struct aws_hash *aws_dotnet_sha1_new(void) {
+typedef struct aws_hash *(aws_dotnet_hash_new_fn)(struct aws_allocator *allocator);
+
+/*
+ * aws_hash contexts can't be reset in place, so .NET holds this wrapper, which remembers how to recreate its hash.
+ * Reset then only replaces the native context, and the managed Hash and its SafeHandle can be reused.
+ */
+struct aws_dotnet_hash {
+    struct aws_allocator *allocator;
+    aws_dotnet_hash_new_fn *new_fn;
+    struct aws_hash *hash;
+};
+
+static struct aws_dotnet_hash *s_hash_new(aws_dotnet_hash_new_fn *new_fn) {
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
-    return aws_sha1_new(allocator);
+    struct aws_dotnet_hash *hash = aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_hash));
+    if (hash == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate hash");
+        return NULL;
+    }
+    hash->allocator = allocator;
+    hash->new_fn = new_fn;
+    hash->hash = new_fn(allocator);
+    if (hash->hash == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to create hash");
+        aws_mem_release(allocator, hash);
+        return NULL;
+    }
+    return hash;
+}
+
+AWS_DOTNET_API
+struct aws_dotnet_hash *aws_dotnet_sha1_new(void) {
+    return s_hash_new(aws_sha1_new);
+}
+
+AWS_DOTNET_API
+struct aws_dotnet_hash *aws_dotnet_sha256_new(void) {
+    return s_hash_new(aws_sha256_new);
+}
+
+AWS_DOTNET_API
+struct aws_dotnet_hash *aws_dotnet_md5_new(void) {
+    return s_hash_new(aws_md5_new);
+}
+
+AWS_DOTNET_API
+void aws_dotnet_hash_reset(struct aws_dotnet_hash *hash) {
+    struct aws_hash *fresh = hash->new_fn(hash->allocator);
+    if (fresh == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to reset hash");
+        return;
+    }
+    aws_hash_destroy(hash->hash);
+    hash->hash = fresh;
 }
 
 AWS_DOTNET_API
-struct aws_hash *aws_dotnet_sha256_new(void) {
+void aws_dotnet_hash_update(struct aws_dotnet_hash *hash, const uint8_t *buffer, uint64_t buffer_size) {
+    struct aws_byte_cursor buffer_cursor = aws_byte_cursor_from_array(buffer, (size_t)buffer_size);
+    if (aws_hash_update(hash->hash, &buffer_cursor)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to update hash");
+    }
+}
+
+/* Writes the digest, or its first truncate_to bytes if truncate_to is not 0, to buffer */
+AWS_DOTNET_API
+void aws_dotnet_hash_digest(struct aws_dotnet_hash *hash, uint32_t truncate_to, uint8_t *buffer, uint32_t buffer_size) {
+    struct aws_byte_buf digest_buf = aws_byte_buf_from_empty_array(buffer, buffer_size);
+    if (aws_hash_finalize(hash->hash, &digest_buf, truncate_to)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to finalize hash");
+    }
+}
+
+AWS_DOTNET_API
+void aws_dotnet_hash_destroy(struct aws_dotnet_hash *hash) {
+    aws_hash_destroy(hash->hash);
+    aws_mem_release(hash->allocator, hash);
+}
+
+static int s_hash_file_region(struct aws_byte_cursor region, void *user_data) {
+    return aws_hash_update(user_data, &region);
+}
+
+/* Feeds [offset, offset + length) of a file to the hash straight from a memory mapping of it */
+AWS_DOTNET_API
+void aws_dotnet_hash_update_file(struct aws_dotnet_hash *hash, const char *path, uint64_t offset, uint64_t length) {
+    if (aws_dotnet_file_for_each_region(path, offset, length, s_hash_file_region, hash->hash)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to hash file %s", path);
+    }
+}
+
+/*
+ * Hashes count independent records of buffer in one call: record i is [offsets[i], offsets[i] + lengths[i]), and
+ * its digest is written to digests + i * digest size. aws-c-cal has no multi-buffer hashing, so each record gets its
+ * own context, but there is no managed allocation or native call per record.
+ */
+static void s_hash_batch(
+    aws_dotnet_hash_new_fn *new_fn,
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint8_t *digests) {
+
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
-    return aws_sha256_new(allocator);
+    uint8_t *digest = digests;
+    for (uint32_t i = 0; i < count; ++i) {
+        struct aws_hash *hash = new_fn(allocator);
+        if (hash == NULL) {
+            aws_dotnet_throw_exception(aws_last_error(), "Unable to create hash");
+            return;
+        }
+
+        struct aws_byte_cursor record = aws_byte_cursor_from_array(buffer + offsets[i], (size_t)lengths[i]);
+        struct aws_byte_buf digest_buf = aws_byte_buf_from_empty_array(digest, hash->digest_size);
+        int result = aws_hash_update(hash, &record) || aws_hash_finalize(hash, &digest_buf, 0);
+        digest += hash->digest_size;
+        aws_hash_destroy(hash);
+
+        if (result) {
+            aws_dotnet_throw_exception(aws_last_error(), "Unable to hash record %u", i);
+            return;
+        }
+    }
+}
+
+AWS_DOTNET_API
+void aws_dotnet_sha1_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint8_t *digests) {
+    s_hash_batch(aws_sha1_new, buffer, offsets, lengths, count, digests);
+}
+
+AWS_DOTNET_API
+void aws_dotnet_sha256_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint8_t *digests) {
+    s_hash_batch(aws_sha256_new, buffer, offsets, lengths, count, digests);
+}
+
+AWS_DOTNET_API
+void aws_dotnet_md5_batch(
+    const uint8_t *buffer,
+    const int32_t *offsets,
+    const int32_t *lengths,
+    uint32_t count,
+    uint8_t *digests) {
+    s_hash_batch(aws_md5_new, buffer, offsets, lengths, count, digests);
 }
 
+/* Must match Aws.Crt.Cal.DigestAlgorithms */
+enum aws_dotnet_digest_algorithm {
+    AWS_DOTNET_DIGEST_MD5 = 1,
+    AWS_DOTNET_DIGEST_SHA1 = 2,
+    AWS_DOTNET_DIGEST_SHA256 = 4,
+    AWS_DOTNET_DIGEST_CRC32 = 8,
+    AWS_DOTNET_DIGEST_CRC32C = 16,
+    AWS_DOTNET_DIGEST_CRC64NVME = 32,
+};
+
+/* Indices into the crcs output of aws_dotnet_digest_set_digest */
+enum aws_dotnet_digest_set_crc {
+    AWS_DOTNET_DIGEST_SET_CRC32,
+    AWS_DOTNET_DIGEST_SET_CRC32C,
+    AWS_DOTNET_DIGEST_SET_CRC64NVME,
+};
+
+/*
+ * Updates are fed to every algorithm this many bytes at a time, so each chunk is read from memory once and is
+ * still in cache for the remaining algorithms
+ */
+#define AWS_DOTNET_DIGEST_SET_CHUNK_SIZE (16 * 1024)
+
+struct aws_dotnet_digest_set {
+    struct aws_allocator *allocator;
+    struct aws_hash *md5;
+    struct aws_hash *sha1;
+    struct aws_hash *sha256;
+    uint32_t algorithms;
+    uint32_t crc32;
+    uint32_t crc32c;
+    uint64_t crc64nvme;
+};
+
 AWS_DOTNET_API
-struct aws_hash *aws_dotnet_md5_new(void) {
+void aws_dotnet_digest_set_destroy(struct aws_dotnet_digest_set *set) {
+    if (set == NULL) {
+        return;
+    }
+
+    if (set->md5) {
+        aws_hash_destroy(set->md5);
+    }
+    if (set->sha1) {
+        aws_hash_destroy(set->sha1);
+    }
+    if (set->sha256) {
+        aws_hash_destroy(set->sha256);
+    }
+    aws_mem_release(set->allocator, set);
+}
+
+AWS_DOTNET_API
+struct aws_dotnet_digest_set *aws_dotnet_digest_set_new(uint32_t algorithms) {
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
-    return aws_md5_new(allocator);
+    struct aws_dotnet_digest_set *set = aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_digest_set));
+    if (set == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate digest set");
+        return NULL;
+    }
+    set->allocator = allocator;
+    set->algorithms = algorithms;
+
+    if ((algorithms & AWS_DOTNET_DIGEST_MD5) && (set->md5 = aws_md5_new(allocator)) == NULL) {
+        goto error;
+    }
+    if ((algorithms & AWS_DOTNET_DIGEST_SHA1) && (set->sha1 = aws_sha1_new(allocator)) == NULL) {
+        goto error;
+    }
+    if ((algorithms & AWS_DOTNET_DIGEST_SHA256) && (set->sha256 = aws_sha256_new(allocator)) == NULL) {
+        goto error;
+    }
+
+    return set;
+
+error:
+    aws_dotnet_throw_exception(aws_last_error(), "Unable to create digest set hashes");
+    aws_dotnet_digest_set_destroy(set);
+    return NULL;
+}
+
+static int s_digest_set_update(struct aws_dotnet_digest_set *set, struct aws_byte_cursor data) {
+    while (data.len > 0) {
+        struct aws_byte_cursor chunk =
+            aws_byte_cursor_advance(&data, aws_min_size(data.len, AWS_DOTNET_DIGEST_SET_CHUNK_SIZE));
+
+        if (set->md5 && aws_hash_update(set->md5, &chunk)) {
+            return AWS_OP_ERR;
+        }
+        if (set->sha1 && aws_hash_update(set->sha1, &chunk)) {
+            return AWS_OP_ERR;
+        }
+        if (set->sha256 && aws_hash_update(set->sha256, &chunk)) {
+            return AWS_OP_ERR;
+        }
+        if (set->algorithms & AWS_DOTNET_DIGEST_CRC32) {
+            set->crc32 = aws_checksums_crc32_ex(chunk.ptr, chunk.len, set->crc32);
+        }
+        if (set->algorithms & AWS_DOTNET_DIGEST_CRC32C) {
+            set->crc32c = aws_checksums_crc32c_ex(chunk.ptr, chunk.len, set->crc32c);
+        }
+        if (set->algorithms & AWS_DOTNET_DIGEST_CRC64NVME) {
+            set->crc64nvme = aws_checksums_crc64nvme_ex(chunk.ptr, chunk.len, set->crc64nvme);
+        }
+    }
+    return AWS_OP_SUCCESS;
 }
 
 AWS_DOTNET_API
-int aws_dotnet_hash_update(struct aws_hash *hash, uint8_t *buffer, uint32_t buffer_size) {
-    struct aws_byte_cursor buffer_cursor;
-    AWS_ZERO_STRUCT(buffer_cursor);
-    buffer_cursor.ptr = buffer;
-    buffer_cursor.len = buffer_size;
-    return aws_hash_update(hash, &buffer_cursor);
+void aws_dotnet_digest_set_update(struct aws_dotnet_digest_set *set, const uint8_t *buffer, uint64_t length) {
+    if (s_digest_set_update(set, aws_byte_cursor_from_array(buffer, (size_t)length))) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to update digest set");
+    }
+}
+
+static int s_digest_set_file_region(struct aws_byte_cursor region, void *user_data) {
+    return s_digest_set_update(user_data, region);
 }
 
 AWS_DOTNET_API
-void aws_dotnet_hash_digest(struct aws_hash *hash, size_t truncate_to, uint8_t *buffer, uint32_t buffer_size) {
-    (void)buffer_size;
+void aws_dotnet_digest_set_update_file(
+    struct aws_dotnet_digest_set *set,
+    const char *path,
+    uint64_t offset,
+    uint64_t length) {
+    if (aws_dotnet_file_for_each_region(path, offset, length, s_digest_set_file_region, set)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to digest file %s", path);
+    }
+}
 
-    struct aws_byte_buf digest_buf = aws_byte_buf_from_array(buffer, hash->digest_size);
-    digest_buf.len = 0;
-    aws_hash_finalize(hash, &digest_buf, truncate_to);
+static int s_finalize_hash(struct aws_hash *hash, uint8_t *output) {
+    if (hash == NULL || output == NULL) {
+        return AWS_OP_SUCCESS;
+    }
+    struct aws_byte_buf digest_buf = aws_byte_buf_from_empty_array(output, hash->digest_size);
+    return aws_hash_finalize(hash, &digest_buf, 0);
 }
 
+/*
+ * Writes every configured digest. Each hash output must have room for its digest size, and crcs for 3 values.
+ * Outputs for algorithms that weren't configured may be NULL.
+ */
 AWS_DOTNET_API
-void aws_dotnet_hash_destroy(struct aws_hash *hash) {
-    aws_hash_destroy(hash);
+void aws_dotnet_digest_set_digest(
+    struct aws_dotnet_digest_set *set,
+    uint8_t *md5,
+    uint8_t *sha1,
+    uint8_t *sha256,
+    uint64_t *crcs) {
+
+    if (s_finalize_hash(set->md5, md5) || s_finalize_hash(set->sha1, sha1) || s_finalize_hash(set->sha256, sha256)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to finalize digest set");
+        return;
+    }
+
+    if (crcs != NULL) {
+        crcs[AWS_DOTNET_DIGEST_SET_CRC32] = set->crc32;
+        crcs[AWS_DOTNET_DIGEST_SET_CRC32C] = set->crc32c;
+        crcs[AWS_DOTNET_DIGEST_SET_CRC64NVME] = set->crc64nvme;
+    }
 }
@@ -0,0 +1,167 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "crt.h"
+#include "exports.h"
+#include "http_client.h"
+#include "stream.h"
+
+#include <aws/common/math.h>
+#include <aws/http/http2_stream_manager.h>
+#include <aws/http/request_response.h>
+#include <aws/io/socket.h>
+
+static struct aws_socket_options s_default_socket_options = {
+    .type = AWS_SOCKET_STREAM,
+    .domain = AWS_SOCKET_IPV4,
+    .connect_timeout_ms = 3000,
+};
+
+/*
+ * Opens HTTP/2 connections to one endpoint, negotiated with ALPN "h2" over TLS or by prior knowledge in plaintext, and
+ * spreads streams over them: a new connection is only opened once every open one has
+ * ideal_concurrent_streams_per_connection streams, and no connection carries more than
+ * max_concurrent_streams_per_connection, or the server's own limit if that is lower. The native manager is ref counted
+ * by its connections and streams, so releasing it here leaves streams in flight to finish.
+ */
+AWS_DOTNET_API
+struct aws_http2_stream_manager *aws_dotnet_http2_stream_manager_new(
+    struct aws_client_bootstrap *client_bootstrap,
+    const char *host_name,
+    uint16_t port,
+    struct aws_socket_options *socket_options,
+    struct aws_tls_connection_options *tls_connection_options,
+    bool http2_prior_knowledge,
+    int32_t max_connections,
+    int32_t ideal_concurrent_streams_per_connection,
+    int32_t max_concurrent_streams_per_connection,
+    uint64_t initial_window_size,
+    bool manual_window_management) {
+
+    if (socket_options == NULL) {
+        socket_options = &s_default_socket_options;
+    }
+
+    struct aws_http2_stream_manager_options options;
+    AWS_ZERO_STRUCT(options);
+
+    options.bootstrap = client_bootstrap;
+    options.socket_options = socket_options;
+    options.tls_connection_options = tls_connection_options;
+    options.http2_prior_knowledge = http2_prior_knowledge && tls_connection_options == NULL;
+    options.host = aws_byte_cursor_from_c_str(host_name);
+    options.port = port;
+    options.max_connections = (size_t)max_connections;
+    options.ideal_concurrent_streams_per_connection = (size_t)ideal_concurrent_streams_per_connection;
+    options.max_concurrent_streams_per_connection = (size_t)max_concurrent_streams_per_connection;
+    /* Per stream: how much response body each stream may receive before managed code opens its window further */
+    options.initial_window_size = (size_t)initial_window_size;
+    options.enable_read_back_pressure = manual_window_management;
+
+    struct aws_http2_stream_manager *manager = aws_http2_stream_manager_new(aws_dotnet_get_allocator(), &options);
+    if (manager == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to create HTTP/2 stream manager");
+        return NULL;
+    }
+
+    return manager;
+}
+
+AWS_DOTNET_API
+void aws_dotnet_http2_stream_manager_destroy(struct aws_http2_stream_manager *manager) {
+    aws_http2_stream_manager_release(manager);
+}
+
+static void s_on_stream_acquired(struct aws_http_stream *http_stream, int error_code, void *user_data) {
+    struct aws_dotnet_http_stream *stream = user_data;
+
+    if (error_code != AWS_ERROR_SUCCESS) {
+        /* No response callbacks will follow, so this is the stream's completion */
+        stream->on_stream_complete(error_code);
+        return;
+    }
+
+    /* Already activated. Response callbacks only start after this, on the same event loop thread. */
+    aws_mutex_lock(&stream->lock);
+    stream->stream = http_stream;
+    uint64_t pending_window_increment = stream->pending_window_increment;
+    stream->pending_window_increment = 0;
+    aws_mutex_unlock(&stream->lock);
+
+    if (pending_window_increment > 0) {
+        aws_http_stream_update_window(http_stream, (size_t)aws_min_u64(pending_window_increment, SIZE_MAX));
+    }
+
+    if (stream->body != NULL) {
+        aws_dotnet_async_body_start(stream->body, http_stream);
+    }
+}
+
+/*
+ * Queues a request on the manager, which makes and activates the stream once a connection has room for it. Failure
+ * to get a connection is reported through on_stream_complete. The stream is destroyed with
+ * aws_dotnet_http_stream_destroy once it completes.
+ */
+AWS_DOTNET_API
+struct aws_dotnet_http_stream *aws_dotnet_http2_stream_manager_make_request(
+    struct aws_http2_stream_manager *manager,
+    const char *method,
+    const char *uri,
+    struct aws_dotnet_http_header headers[],
+    uint32_t header_count,
+    struct aws_dotnet_stream_function_table body_stream_delegates,
+    aws_dotnet_http_on_incoming_headers_fn *on_incoming_headers,
+    aws_dotnet_http_on_incoming_header_block_done_fn *on_incoming_headers_block_done,
+    aws_dotnet_http_on_incoming_body_fn *on_incoming_body,
+    aws_dotnet_http_on_stream_complete_fn *on_stream_complete) {
+
+    if (on_incoming_headers == NULL) {
+        aws_dotnet_throw_exception(AWS_ERROR_INVALID_ARGUMENT, "on_incoming_headers must be provided");
+        return NULL;
+    }
+
+    if (on_stream_complete == NULL) {
+        aws_dotnet_throw_exception(AWS_ERROR_INVALID_ARGUMENT, "on_stream_complete must be provided");
+        return NULL;
+    }
+
+    struct aws_dotnet_http_stream *stream = aws_dotnet_http_stream_wrapper_new();
+    if (!stream) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate aws_dotnet_http_stream");
+        return NULL;
+    }
+
+    stream->on_incoming_headers = on_incoming_headers;
+    stream->on_incoming_headers_block_done = on_incoming_headers_block_done;
+    stream->on_incoming_body = on_incoming_body;
+    stream->on_stream_complete = on_stream_complete;
+
+    /* HTTP/1.1 style requests are converted to HTTP/2 when the stream is made */
+    stream->request = aws_build_http_request(method, uri, headers, header_count, &body_stream_delegates);
+    if (stream->request == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to build HTTP request");
+        aws_dotnet_http_stream_destroy(stream);
+        return NULL;
+    }
+
+    struct aws_http_make_request_options request_options;
+    aws_dotnet_http_stream_init_request_options(stream, &request_options);
+
+    if (aws_dotnet_http_stream_init_async_body(stream, &body_stream_delegates, AWS_HTTP_VERSION_2, &request_options)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to send async body");
+        aws_dotnet_http_stream_destroy(stream);
+        return NULL;
+    }
+
+    struct aws_http2_stream_manager_acquire_stream_options acquire_options;
+    AWS_ZERO_STRUCT(acquire_options);
+    acquire_options.callback = s_on_stream_acquired;
+    acquire_options.user_data = stream;
+    acquire_options.options = &request_options;
+
+    aws_http2_stream_manager_acquire_stream(manager, &acquire_options);
+
+    return stream;
+}
@@ -6,23 +6,18 @@
 #include "http_client.h"
 #include "crt.h"
 #include "exports.h"
+#include "http_connection_manager.h"
 #include "stream.h"
 
+#include <aws/common/math.h>
 #include <aws/common/string.h>
 #include <aws/http/connection.h>
 #include <aws/http/request_response.h>
 #include <aws/io/socket.h>
 #include <aws/io/stream.h>
 
-typedef void(DOTNET_CALL aws_dotnet_http_on_client_connection_setup_fn)(int error_code);
-
-typedef void(DOTNET_CALL aws_dotnet_http_on_client_connection_shutdown_fn)(int error_code);
-
-struct aws_dotnet_http_connection {
-    struct aws_http_connection *connection;
-    aws_dotnet_http_on_client_connection_setup_fn *on_setup;
-    aws_dotnet_http_on_client_connection_shutdown_fn *on_shutdown;
-};
+#include <inttypes.h>
+#include <stdio.h>
 
 static void s_http_connection_on_setup(struct aws_http_connection *connection, int error_code, void *user_data) {
     (void)connection;
@@ -52,6 +47,8 @@ struct aws_dotnet_http_connection *aws_dotnet_http_connection_new(
     uint16_t port,
     struct aws_socket_options *socket_options,
     struct aws_tls_connection_options *tls_connection_options,
+    bool http2_prior_knowledge,
+    bool manual_window_management,
     aws_dotnet_http_on_client_connection_setup_fn *on_setup,
     aws_dotnet_http_on_client_connection_shutdown_fn *on_shutdown) {
 
@@ -69,6 +66,8 @@ struct aws_dotnet_http_connection *aws_dotnet_http_connection_new(
     if (initial_window_size != 0) {
         options.initial_window_size = (size_t)initial_window_size;
     }
+    /* Response bodies stop being read once initial_window_size is received, until managed code opens the window */
+    options.manual_window_management = manual_window_management;
     options.host_name = aws_byte_cursor_from_c_str(host_name);
     options.port = port;
     if (!socket_options) {
@@ -76,6 +75,8 @@ struct aws_dotnet_http_connection *aws_dotnet_http_connection_new(
     }
     options.socket_options = socket_options;
     options.tls_options = tls_connection_options;
+    /* Plaintext HTTP/2 without upgrade; over TLS, HTTP/2 is negotiated with ALPN "h2" instead */
+    options.prior_knowledge_http2 = http2_prior_knowledge && tls_connection_options == NULL;
     options.on_setup = s_http_connection_on_setup;
     options.on_shutdown = s_http_connection_on_shutdown;
     options.user_data = connection;
@@ -93,38 +94,21 @@ struct aws_dotnet_http_connection *aws_dotnet_http_connection_new(
 
 AWS_DOTNET_API
 void aws_dotnet_http_connection_destroy(struct aws_dotnet_http_connection *connection) {
-    aws_http_connection_close(connection->connection);
+    if (connection->manager != NULL) {
+        aws_dotnet_http_client_connection_manager_release_connection(connection->manager, connection->connection);
+    } else {
+        aws_http_connection_close(connection->connection);
+    }
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
     aws_mem_release(allocator, connection);
 }
 
-typedef void(aws_dotnet_http_on_incoming_headers_fn)(
-    int32_t status_code,
-    int32_t header_block,
-    struct aws_dotnet_http_header headers[],
-    uint32_t header_count);
-typedef void(aws_dotnet_http_on_incoming_header_block_done_fn)(bool has_body);
-typedef void(aws_dotnet_http_on_incoming_body_fn)(uint8_t *data, uint64_t size);
-typedef void(aws_dotnet_http_on_stream_complete_fn)(int error_code);
-
-struct aws_dotnet_http_stream {
-    struct aws_dotnet_http_connection *connection;
-    struct aws_http_stream *stream;
-    struct aws_http_message *request;
-
-    aws_dotnet_http_on_incoming_headers_fn *on_incoming_headers;
-    aws_dotnet_http_on_incoming_header_block_done_fn *on_incoming_headers_block_done;
-    aws_dotnet_http_on_incoming_body_fn *on_incoming_body;
-    aws_dotnet_http_on_stream_complete_fn *on_stream_complete;
-};
-
 static int s_stream_on_incoming_headers(
     struct aws_http_stream *s,
     enum aws_http_header_block header_block,
     const struct aws_http_header *headers,
     size_t header_count,
     void *user_data) {
-    (void)s;
 
     struct aws_dotnet_http_stream *stream = user_data;
     AWS_VARIABLE_LENGTH_ARRAY(struct aws_dotnet_http_header, dotnet_headers, header_count);
@@ -137,7 +121,7 @@ static int s_stream_on_incoming_headers(
     }
 
     int status = 0;
-    aws_http_stream_get_incoming_response_status(stream->stream, &status);
+    aws_http_stream_get_incoming_response_status(s, &status);
     stream->on_incoming_headers(status, header_block, dotnet_headers, (uint32_t)header_count);
 
     return AWS_OP_SUCCESS;
@@ -172,6 +156,30 @@ static void s_stream_on_stream_complete(struct aws_http_stream *s, int error_cod
     stream->on_stream_complete(error_code);
 }
 
+/* Bodies of known length are sent with a Content-Length, unless the caller has already framed the body */
+static int s_add_content_length_if_missing(struct aws_http_message *request, struct aws_input_stream *body_stream) {
+    struct aws_http_headers *headers = aws_http_message_get_headers(request);
+    if (aws_http_headers_has(headers, aws_byte_cursor_from_c_str("Content-Length")) ||
+        aws_http_headers_has(headers, aws_byte_cursor_from_c_str("Transfer-Encoding"))) {
+        return AWS_OP_SUCCESS;
+    }
+
+    int64_t length = 0;
+    if (aws_input_stream_get_length(body_stream, &length)) {
+        return AWS_OP_ERR;
+    }
+
+    char length_str[32];
+    snprintf(length_str, sizeof(length_str), "%" PRIi64, length);
+
+    struct aws_http_header header;
+    AWS_ZERO_STRUCT(header);
+    header.name = aws_byte_cursor_from_c_str("Content-Length");
+    header.value = aws_byte_cursor_from_c_str(length_str);
+
+    return aws_http_message_add_header(request, header);
+}
+
 struct aws_http_message *aws_build_http_request(
     const char *method,
     const char *uri,
@@ -197,14 +205,16 @@ struct aws_http_message *aws_build_http_request(
         struct aws_http_header header;
         AWS_ZERO_STRUCT(header);
 
-        header.name = aws_byte_cursor_from_c_str(headers[i].name);
-        header.value = aws_byte_cursor_from_c_str(headers[i].value);
+        header.name = aws_byte_cursor_from_array(headers[i].name, (size_t)headers[i].name_size);
+        header.value = aws_byte_cursor_from_array(headers[i].value, (size_t)headers[i].value_size);
         if (aws_http_message_add_header(request, header)) {
             goto on_error;
         }
     }
 
-    if (aws_stream_function_table_is_valid(body_stream_delegates)) {
+    /* Async bodies aren't set on the request, but pushed to the stream once it is made */
+    if (aws_stream_function_table_is_valid(body_stream_delegates) &&
+        !aws_stream_function_table_is_async(body_stream_delegates)) {
         struct aws_input_stream *body_stream = aws_input_stream_new_dotnet(allocator, body_stream_delegates);
         if (body_stream == NULL) {
             goto on_error;
@@ -213,6 +223,11 @@ struct aws_http_message *aws_build_http_request(
         aws_http_message_set_body_stream(request, body_stream);
         /* request takes the ownership */
         aws_input_stream_release(body_stream);
+
+        if (aws_stream_function_table_is_file(body_stream_delegates) &&
+            s_add_content_length_if_missing(request, body_stream)) {
+            goto on_error;
+        }
     }
 
     return request;
@@ -236,8 +251,8 @@ struct aws_http_headers *aws_build_http_headers(struct aws_dotnet_http_header he
         struct aws_http_header header;
         AWS_ZERO_STRUCT(header);
 
-        header.name = aws_byte_cursor_from_c_str(headers[i].name);
-        header.value = aws_byte_cursor_from_c_str(headers[i].value);
+        header.name = aws_byte_cursor_from_array(headers[i].name, (size_t)headers[i].name_size);
+        header.value = aws_byte_cursor_from_array(headers[i].value, (size_t)headers[i].value_size);
         if (aws_http_headers_add_header(c_headers, &header)) {
             goto on_error;
         }
@@ -252,6 +267,73 @@ on_error:
     return NULL;
 }
 
+/* The negotiated protocol, an enum aws_http_version; unknown until the connection is set up */
+AWS_DOTNET_API
+int32_t aws_dotnet_http_connection_get_version(struct aws_dotnet_http_connection *connection) {
+    if (connection->connection == NULL) {
+        return AWS_HTTP_VERSION_UNKNOWN;
+    }
+
+    return (int32_t)aws_http_connection_get_version(connection->connection);
+}
+
+void aws_dotnet_http_stream_init_request_options(
+    struct aws_dotnet_http_stream *stream,
+    struct aws_http_make_request_options *options) {
+
+    AWS_ZERO_STRUCT(*options);
+    options->self_size = sizeof(struct aws_http_make_request_options);
+    options->request = stream->request;
+    options->on_response_headers = s_stream_on_incoming_headers;
+    options->on_response_header_block_done = s_stream_on_incoming_header_block_done;
+    options->on_response_body = s_stream_on_incoming_body;
+    options->on_complete = s_stream_on_stream_complete;
+    options->user_data = stream;
+}
+
+/* HTTP/1.1 can only push a body as it is read in chunks, whose length isn't known up front */
+static int s_use_chunked_encoding(struct aws_http_message *request) {
+    struct aws_http_headers *headers = aws_http_message_get_headers(request);
+    if (aws_http_headers_has(headers, aws_byte_cursor_from_c_str("Content-Length"))) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (aws_http_headers_has(headers, aws_byte_cursor_from_c_str("Transfer-Encoding"))) {
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_http_header header;
+    AWS_ZERO_STRUCT(header);
+    header.name = aws_byte_cursor_from_c_str("Transfer-Encoding");
+    header.value = aws_byte_cursor_from_c_str("chunked");
+
+    return aws_http_message_add_header(request, header);
+}
+
+int aws_dotnet_http_stream_init_async_body(
+    struct aws_dotnet_http_stream *stream,
+    struct aws_dotnet_stream_function_table *body_stream_delegates,
+    enum aws_http_version version,
+    struct aws_http_make_request_options *options) {
+
+    if (!aws_stream_function_table_is_async(body_stream_delegates)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (version == AWS_HTTP_VERSION_2) {
+        options->http2_use_manual_data_writes = true;
+    } else if (s_use_chunked_encoding(stream->request)) {
+        return AWS_OP_ERR;
+    }
+
+    stream->body = aws_dotnet_async_body_new(aws_dotnet_get_allocator(), body_stream_delegates);
+    if (stream->body == NULL) {
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 static void s_destroy_stream_wrapper(struct aws_dotnet_http_stream *stream_wrapper) {
     if (stream_wrapper == NULL) {
         return;
@@ -261,11 +343,36 @@ static void s_destroy_stream_wrapper(struct aws_dotnet_http_stream *stream_wrapp
         aws_http_message_release(stream_wrapper->request);
     }
 
+    /* A body that has started sending owns the stream, and releases it once its last read or write has finished */
+    struct aws_http_stream *http_stream = stream_wrapper->stream;
+    if (stream_wrapper->body != NULL) {
+        if (aws_dotnet_async_body_is_sending(stream_wrapper->body)) {
+            http_stream = NULL;
+        }
+        aws_dotnet_async_body_release(stream_wrapper->body);
+    }
+
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
-    aws_http_stream_release(stream_wrapper->stream);
+    aws_http_stream_release(http_stream);
+    aws_mutex_clean_up(&stream_wrapper->lock);
     aws_mem_release(allocator, stream_wrapper);
 }
 
+struct aws_dotnet_http_stream *aws_dotnet_http_stream_wrapper_new(void) {
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+    struct aws_dotnet_http_stream *stream = aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_http_stream));
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    if (aws_mutex_init(&stream->lock)) {
+        aws_mem_release(allocator, stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
 AWS_DOTNET_API struct aws_dotnet_http_stream *aws_dotnet_http_stream_new(
     struct aws_dotnet_http_connection *connection,
     const char *method,
@@ -298,9 +405,7 @@ AWS_DOTNET_API struct aws_dotnet_http_stream *aws_dotnet_http_stream_new(
         return NULL;
     }
 
-    struct aws_allocator *allocator = aws_dotnet_get_allocator();
-
-    struct aws_dotnet_http_stream *stream = aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_http_stream));
+    struct aws_dotnet_http_stream *stream = aws_dotnet_http_stream_wrapper_new();
     if (!stream) {
         aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate aws_dotnet_http_stream");
         return NULL;
@@ -318,14 +423,17 @@ AWS_DOTNET_API struct aws_dotnet_http_stream *aws_dotnet_http_stream_new(
     }
 
     struct aws_http_make_request_options options;
-    AWS_ZERO_STRUCT(options);
-    options.self_size = sizeof(struct aws_http_make_request_options);
-    options.request = stream->request;
-    options.on_response_headers = s_stream_on_incoming_headers;
-    options.on_response_header_block_done = s_stream_on_incoming_header_block_done;
-    options.on_response_body = s_stream_on_incoming_body;
-    options.on_complete = s_stream_on_stream_complete;
-    options.user_data = stream;
+    aws_dotnet_http_stream_init_request_options(stream, &options);
+
+    if (aws_dotnet_http_stream_init_async_body(
+            stream,
+            &body_stream_delegates,
+            aws_http_connection_get_version(connection->connection),
+            &options)) {
+        aws_dotnet_throw_exception(
+            aws_last_error(), "Unable to send async body, which can't have a Content-Length on HTTP/1.1");
+        goto on_error;
+    }
 
     stream->stream = aws_http_connection_make_request(connection->connection, &options);
     if (!stream->stream) {
@@ -354,7 +462,17 @@ AWS_DOTNET_API void aws_dotnet_http_stream_update_window(
         return;
     }
 
-    aws_http_stream_update_window(stream->stream, (size_t)increment_size);
+    /* A stream from an HTTP/2 stream manager has no aws_http_stream until it is acquired, which applies the rest */
+    aws_mutex_lock(&stream->lock);
+    struct aws_http_stream *http_stream = stream->stream;
+    if (http_stream == NULL) {
+        stream->pending_window_increment = aws_add_u64_saturating(stream->pending_window_increment, increment_size);
+    }
+    aws_mutex_unlock(&stream->lock);
+
+    if (http_stream != NULL) {
+        aws_http_stream_update_window(http_stream, (size_t)aws_min_u64(increment_size, SIZE_MAX));
+    }
 }
 
 AWS_DOTNET_API void aws_dotnet_http_stream_activate(struct aws_dotnet_http_stream *stream) {
@@ -363,5 +481,12 @@ AWS_DOTNET_API void aws_dotnet_http_stream_activate(struct aws_dotnet_http_strea
         return;
     }
 
-    aws_http_stream_activate(stream->stream);
+    /* Streams from an HTTP/2 stream manager are activated by the manager */
+    if (stream->connection == NULL) {
+        return;
+    }
+
+    if (aws_http_stream_activate(stream->stream) == AWS_OP_SUCCESS && stream->body != NULL) {
+        aws_dotnet_async_body_start(stream->body, stream->stream);
+    }
 }
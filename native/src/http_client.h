@@ -6,11 +6,43 @@
 #ifndef AWS_DOTNET_HTTP_CLIENT_H
 #define AWS_DOTNET_HTTP_CLIENT_H
 
+#include "crt.h"
+#include "exports.h"
+
 #include <aws/common/common.h>
+#include <aws/common/mutex.h>
+#include <aws/http/http.h>
 
+struct aws_http_connection;
+struct aws_dotnet_async_body;
+struct aws_dotnet_http_client_connection_manager;
+struct aws_http_make_request_options;
 struct aws_http_message;
+struct aws_http_stream;
 struct aws_dotnet_stream_function_table;
 
+typedef void(DOTNET_CALL aws_dotnet_http_on_client_connection_setup_fn)(int error_code);
+
+typedef void(DOTNET_CALL aws_dotnet_http_on_client_connection_shutdown_fn)(int error_code);
+
+/*
+ * A client connection handed to managed code, either connected directly or acquired from a connection manager.
+ * Destroying an acquired connection releases it back to its manager instead of closing it.
+ */
+struct aws_dotnet_http_connection {
+    struct aws_http_connection *connection;
+    aws_dotnet_http_on_client_connection_setup_fn *on_setup;
+    aws_dotnet_http_on_client_connection_shutdown_fn *on_shutdown;
+
+    /* The manager the connection was acquired from, which it holds a reference to, or NULL */
+    struct aws_dotnet_http_client_connection_manager *manager;
+};
+
+/*
+ * A header as passed between managed and native code.  Names and values are not NUL-terminated, and request headers
+ * from managed code point into one contiguous UTF-8 buffer, so the sizes are always used.  Headers are copied when a
+ * request is built from them, so they need only live for the duration of the call.
+ */
 struct aws_dotnet_http_header {
     const char *name;
     const char *value;
@@ -18,6 +50,60 @@ struct aws_dotnet_http_header {
     int32_t value_size;
 };
 
+typedef void(aws_dotnet_http_on_incoming_headers_fn)(
+    int32_t status_code,
+    int32_t header_block,
+    struct aws_dotnet_http_header headers[],
+    uint32_t header_count);
+typedef void(aws_dotnet_http_on_incoming_header_block_done_fn)(bool has_body);
+typedef void(aws_dotnet_http_on_incoming_body_fn)(uint8_t *data, uint64_t size);
+typedef void(aws_dotnet_http_on_stream_complete_fn)(int error_code);
+
+/* A request stream handed to managed code, made on a connection or acquired from an HTTP/2 stream manager */
+struct aws_dotnet_http_stream {
+    /* NULL for streams from a stream manager */
+    struct aws_dotnet_http_connection *connection;
+    struct aws_http_message *request;
+
+    /*
+     * A stream manager sets stream on an event loop thread once it is acquired, while managed code may already be
+     * opening its window, so increments made before then are held in pending_window_increment.  Both guarded by lock.
+     */
+    struct aws_mutex lock;
+    struct aws_http_stream *stream;
+    uint64_t pending_window_increment;
+
+    /* A body read with async reads, which is pushed to the stream once it is activated, or NULL */
+    struct aws_dotnet_async_body *body;
+
+    aws_dotnet_http_on_incoming_headers_fn *on_incoming_headers;
+    aws_dotnet_http_on_incoming_header_block_done_fn *on_incoming_headers_block_done;
+    aws_dotnet_http_on_incoming_body_fn *on_incoming_body;
+    aws_dotnet_http_on_stream_complete_fn *on_stream_complete;
+};
+
+/* Fills in options to make stream's request, delivering the response to stream's managed callbacks */
+void aws_dotnet_http_stream_init_request_options(
+    struct aws_dotnet_http_stream *stream,
+    struct aws_http_make_request_options *options);
+
+/*
+ * Sets up stream to send the async body of body_stream_delegates, if it has one, over a connection of version. On
+ * HTTP/1.1 the body is chunked, so the request can't have a Content-Length; on HTTP/2 options are set for manual
+ * data writes. Returns AWS_OP_ERR, with the error raised, if it can't.
+ */
+int aws_dotnet_http_stream_init_async_body(
+    struct aws_dotnet_http_stream *stream,
+    struct aws_dotnet_stream_function_table *body_stream_delegates,
+    enum aws_http_version version,
+    struct aws_http_make_request_options *options);
+
+/* Allocates a zeroed stream wrapper with its lock initialized, or returns NULL with the error raised */
+struct aws_dotnet_http_stream *aws_dotnet_http_stream_wrapper_new(void);
+
+AWS_DOTNET_API
+void aws_dotnet_http_stream_destroy(struct aws_dotnet_http_stream *stream);
+
 struct aws_http_message *aws_build_http_request(
     const char *method,
     const char *uri,
@@ -13,25 +13,56 @@
  * permissions and limitations under the License.
  */
 
+#include "http_connection_manager.h"
 #include "crt.h"
 #include "exports.h"
+#include "http_client.h"
 
+#include <aws/common/ref_count.h>
+#include <aws/http/connection.h>
 #include <aws/http/connection_manager.h>
+#include <aws/io/socket.h>
 
+typedef void(DOTNET_CALL aws_dotnet_http_on_connection_acquired_fn)(
+    uint64_t callback_id,
+    int error_code,
+    struct aws_dotnet_http_connection *connection);
+
+/* Held by managed code, and by every pending acquisition and leased connection, so the pool outlives them all */
 struct aws_dotnet_http_client_connection_manager {
+    struct aws_allocator *allocator;
     struct aws_http_connection_manager *manager;
+    struct aws_ref_count ref_count;
 };
 
-static void s_destroy_connection_manager_wrapper(struct aws_dotnet_http_client_connection_manager *wrapper) {
-    if (wrapper == NULL) {
-        return;
-    }
+/* Must match HttpClientConnectionManager.API.NativeMetrics */
+struct aws_dotnet_http_connection_manager_metrics {
+    uint64_t available_connections;
+    uint64_t leased_connections;
+    uint64_t pending_acquisitions;
+};
+
+struct aws_dotnet_http_connection_acquisition {
+    struct aws_dotnet_http_client_connection_manager *manager;
+    uint64_t callback_id;
+    aws_dotnet_http_on_connection_acquired_fn *on_acquired;
+};
+
+static struct aws_socket_options s_default_socket_options = {
+    .type = AWS_SOCKET_STREAM,
+    .domain = AWS_SOCKET_IPV4,
+    .connect_timeout_ms = 3000,
+};
+
+static void s_destroy_connection_manager_wrapper(void *object) {
+    struct aws_dotnet_http_client_connection_manager *wrapper = object;
 
     aws_http_connection_manager_release(wrapper->manager);
 
-    aws_mem_release(aws_dotnet_get_allocator(), wrapper);
+    aws_mem_release(wrapper->allocator, wrapper);
 }
 
+AWS_DOTNET_API
 struct aws_dotnet_http_client_connection_manager *aws_dotnet_http_client_connection_manager_new(
     struct aws_client_bootstrap *client_bootstrap,
     const char *host_name,
@@ -39,15 +70,24 @@ struct aws_dotnet_http_client_connection_manager *aws_dotnet_http_client_connect
     struct aws_socket_options *socket_options,
     struct aws_tls_connection_options *tls_connection_options,
     int32_t max_connections,
-    uint64_t initial_window_size) {
+    uint64_t initial_window_size,
+    uint64_t max_connection_idle_ms,
+    bool manual_window_management) {
 
     struct aws_allocator *allocator = aws_dotnet_get_allocator();
     struct aws_dotnet_http_client_connection_manager *wrapper =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_http_client_connection_manager));
     if (wrapper == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate HTTP connection manager");
         return NULL;
     }
 
+    wrapper->allocator = allocator;
+
+    if (socket_options == NULL) {
+        socket_options = &s_default_socket_options;
+    }
+
     struct aws_http_connection_manager_options options;
     AWS_ZERO_STRUCT(options);
 
@@ -58,21 +98,98 @@ struct aws_dotnet_http_client_connection_manager *aws_dotnet_http_client_connect
     options.host = aws_byte_cursor_from_c_str(host_name);
     options.port = port;
     options.max_connections = max_connections;
+    options.max_connection_idle_in_milliseconds = max_connection_idle_ms;
+    options.enable_read_back_pressure = manual_window_management;
 
     wrapper->manager = aws_http_connection_manager_new(allocator, &options);
     if (wrapper->manager == NULL) {
-        goto on_error;
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to create HTTP connection manager");
+        aws_mem_release(allocator, wrapper);
+        return NULL;
     }
 
+    aws_ref_count_init(&wrapper->ref_count, wrapper, s_destroy_connection_manager_wrapper);
+
     return wrapper;
+}
 
-on_error:
+AWS_DOTNET_API
+void aws_dotnet_http_client_connection_manager_destroy(struct aws_dotnet_http_client_connection_manager *manager) {
+    if (manager == NULL) {
+        return;
+    }
 
-    s_destroy_connection_manager_wrapper(wrapper);
+    aws_ref_count_release(&manager->ref_count);
+}
+
+static void s_on_connection_acquired(struct aws_http_connection *connection, int error_code, void *user_data) {
+    struct aws_dotnet_http_connection_acquisition *acquisition = user_data;
+    struct aws_dotnet_http_client_connection_manager *manager = acquisition->manager;
+
+    struct aws_dotnet_http_connection *dotnet_connection = NULL;
+    if (error_code == AWS_ERROR_SUCCESS) {
+        dotnet_connection = aws_mem_calloc(manager->allocator, 1, sizeof(struct aws_dotnet_http_connection));
+        if (dotnet_connection == NULL) {
+            error_code = aws_last_error();
+            aws_http_connection_manager_release_connection(manager->manager, connection);
+        } else {
+            /* The lease keeps the manager alive until it is released back to it */
+            dotnet_connection->connection = connection;
+            dotnet_connection->manager = manager;
+            aws_ref_count_acquire(&manager->ref_count);
+        }
+    }
 
-    return NULL;
+    acquisition->on_acquired(acquisition->callback_id, error_code, dotnet_connection);
+
+    aws_ref_count_release(&manager->ref_count);
+    aws_mem_release(manager->allocator, acquisition);
 }
 
-void aws_dotnet_http_client_connection_manager_destroy(struct aws_dotnet_http_client_connection_manager *manager) {
-    s_destroy_connection_manager_wrapper(manager);
+/*
+ * Acquires a connection, reusing an idle one if there is one, and completes with it on an event loop thread.  The
+ * connection is released back to the manager by aws_dotnet_http_connection_destroy.
+ */
+AWS_DOTNET_API
+void aws_dotnet_http_client_connection_manager_acquire_connection(
+    struct aws_dotnet_http_client_connection_manager *manager,
+    uint64_t callback_id,
+    aws_dotnet_http_on_connection_acquired_fn *on_acquired) {
+
+    struct aws_dotnet_http_connection_acquisition *acquisition =
+        aws_mem_calloc(manager->allocator, 1, sizeof(struct aws_dotnet_http_connection_acquisition));
+    if (acquisition == NULL) {
+        on_acquired(callback_id, aws_last_error(), NULL);
+        return;
+    }
+
+    /* The acquisition may outlive the managed manager, so it holds its own reference */
+    acquisition->manager = manager;
+    acquisition->callback_id = callback_id;
+    acquisition->on_acquired = on_acquired;
+    aws_ref_count_acquire(&manager->ref_count);
+
+    aws_http_connection_manager_acquire_connection(manager->manager, s_on_connection_acquired, acquisition);
+}
+
+void aws_dotnet_http_client_connection_manager_release_connection(
+    struct aws_dotnet_http_client_connection_manager *manager,
+    struct aws_http_connection *connection) {
+
+    aws_http_connection_manager_release_connection(manager->manager, connection);
+    aws_ref_count_release(&manager->ref_count);
+}
+
+AWS_DOTNET_API
+void aws_dotnet_http_client_connection_manager_fetch_metrics(
+    struct aws_dotnet_http_client_connection_manager *manager,
+    struct aws_dotnet_http_connection_manager_metrics *out_metrics) {
+
+    struct aws_http_manager_metrics metrics;
+    AWS_ZERO_STRUCT(metrics);
+    aws_http_connection_manager_fetch_metrics(manager->manager, &metrics);
+
+    out_metrics->available_connections = metrics.available_concurrency;
+    out_metrics->leased_connections = metrics.leased_concurrency;
+    out_metrics->pending_acquisitions = metrics.pending_concurrency_acquires;
 }
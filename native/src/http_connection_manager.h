@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_DOTNET_HTTP_CONNECTION_MANAGER_H
+#define AWS_DOTNET_HTTP_CONNECTION_MANAGER_H
+
+struct aws_http_connection;
+struct aws_dotnet_http_client_connection_manager;
+
+/* Returns a connection leased from manager to its pool, and drops the lease's reference to manager */
+void aws_dotnet_http_client_connection_manager_release_connection(
+    struct aws_dotnet_http_client_connection_manager *manager,
+    struct aws_http_connection *connection);
+
+#endif /* AWS_DOTNET_HTTP_CONNECTION_MANAGER_H */
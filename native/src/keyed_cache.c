@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "keyed_cache.h"
+#include "crt.h"
+
+#include <aws/cal/hash.h>
+#include <aws/common/byte_order.h>
+#include <aws/common/lru_cache.h>
+#include <aws/common/string.h>
+
+static void s_destroy_cache_key(void *key) {
+    aws_string_destroy(key);
+}
+
+int aws_dotnet_keyed_cache_digest(
+    const struct aws_byte_cursor *parts,
+    size_t part_count,
+    struct aws_byte_buf *digest) {
+
+    struct aws_hash *sha256 = aws_sha256_new(aws_dotnet_get_allocator());
+    if (sha256 == NULL) {
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+    for (size_t i = 0; i < part_count; ++i) {
+        uint8_t length_storage[sizeof(uint64_t)];
+        aws_write_u64((uint64_t)parts[i].len, length_storage);
+        struct aws_byte_cursor length = aws_byte_cursor_from_array(length_storage, sizeof(length_storage));
+        if (aws_hash_update(sha256, &length) || aws_hash_update(sha256, &parts[i])) {
+            goto done;
+        }
+    }
+    result = aws_hash_finalize(sha256, digest, 0);
+
+done:
+    aws_hash_destroy(sha256);
+    return result;
+}
+
+static struct aws_cache *s_new_lru(struct aws_dotnet_keyed_cache *cache, size_t capacity) {
+    return aws_cache_new_lru(
+        aws_dotnet_get_allocator(),
+        aws_hash_string,
+        aws_hash_callback_string_eq,
+        s_destroy_cache_key,
+        cache->destroy_value,
+        capacity);
+}
+
+int aws_dotnet_keyed_cache_configure(struct aws_dotnet_keyed_cache *cache, size_t capacity) {
+    struct aws_cache *lru = NULL;
+    if (capacity > 0) {
+        lru = s_new_lru(cache, capacity);
+        if (lru == NULL) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    aws_mutex_lock(&cache->lock);
+    struct aws_cache *previous = cache->cache;
+    cache->cache = lru;
+    cache->hits = 0;
+    cache->misses = 0;
+    aws_mutex_unlock(&cache->lock);
+
+    if (previous != NULL) {
+        aws_cache_destroy(previous);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+/* Must be called under the lock */
+static struct aws_cache *s_get_lru(struct aws_dotnet_keyed_cache *cache) {
+    if (cache->cache == NULL && cache->default_capacity > 0) {
+        cache->cache = s_new_lru(cache, cache->default_capacity);
+    }
+    return cache->cache;
+}
+
+bool aws_dotnet_keyed_cache_find(
+    struct aws_dotnet_keyed_cache *cache,
+    struct aws_byte_cursor digest,
+    aws_dotnet_keyed_cache_on_hit_fn *on_hit,
+    void *user_data) {
+
+    struct aws_string *key = aws_string_new_from_cursor(aws_dotnet_get_allocator(), &digest);
+    if (key == NULL) {
+        return false;
+    }
+
+    bool found = false;
+    aws_mutex_lock(&cache->lock);
+    struct aws_cache *lru = s_get_lru(cache);
+    if (lru != NULL) {
+        void *value = NULL;
+        if (aws_cache_find(lru, key, &value) == AWS_OP_SUCCESS && value != NULL) {
+            on_hit(value, user_data);
+            found = true;
+            ++cache->hits;
+        } else {
+            ++cache->misses;
+        }
+    }
+    aws_mutex_unlock(&cache->lock);
+
+    aws_string_destroy(key);
+    return found;
+}
+
+bool aws_dotnet_keyed_cache_put(struct aws_dotnet_keyed_cache *cache, struct aws_byte_cursor digest, void *value) {
+    struct aws_string *key = aws_string_new_from_cursor(aws_dotnet_get_allocator(), &digest);
+    if (key == NULL) {
+        return false;
+    }
+
+    aws_mutex_lock(&cache->lock);
+    struct aws_cache *lru = s_get_lru(cache);
+    bool cached = lru != NULL && aws_cache_put(lru, key, value) == AWS_OP_SUCCESS;
+    aws_mutex_unlock(&cache->lock);
+
+    if (!cached) {
+        aws_string_destroy(key);
+    }
+    return cached;
+}
+
+void aws_dotnet_keyed_cache_get_stats(struct aws_dotnet_keyed_cache *cache, uint64_t *stats) {
+    aws_mutex_lock(&cache->lock);
+    stats[AWS_DOTNET_KEYED_CACHE_HITS] = cache->hits;
+    stats[AWS_DOTNET_KEYED_CACHE_MISSES] = cache->misses;
+    stats[AWS_DOTNET_KEYED_CACHE_COUNT] = cache->cache ? aws_cache_get_element_count(cache->cache) : 0;
+    aws_mutex_unlock(&cache->lock);
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_DOTNET_KEYED_CACHE_H
+#define AWS_DOTNET_KEYED_CACHE_H
+
+#include <aws/common/byte_buf.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/mutex.h>
+
+struct aws_cache;
+
+/* Indices into the stats output of aws_dotnet_keyed_cache_get_stats */
+enum aws_dotnet_keyed_cache_stat {
+    AWS_DOTNET_KEYED_CACHE_HITS,
+    AWS_DOTNET_KEYED_CACHE_MISSES,
+    AWS_DOTNET_KEYED_CACHE_COUNT,
+    AWS_DOTNET_KEYED_CACHE_STAT_COUNT,
+};
+
+/*
+ * Process wide, thread safe, bounded LRU cache of values derived from secrets. Entries are keyed by a SHA-256 of the
+ * identity they were derived from, so the secrets themselves are never kept. With a non-zero default_capacity the
+ * LRU is created on first use, otherwise it is disabled until configured.
+ */
+struct aws_dotnet_keyed_cache {
+    struct aws_mutex lock;
+    struct aws_cache *cache;
+    size_t default_capacity;
+    aws_hash_callback_destroy_fn *destroy_value;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+#define AWS_DOTNET_KEYED_CACHE_INIT(capacity, destroy)                                                                 \
+    { .lock = AWS_MUTEX_INIT, .cache = NULL, .default_capacity = (capacity), .destroy_value = (destroy), .hits = 0,     \
+      .misses = 0 }
+
+/* Called under the cache's lock with a cached value, to copy it or take a reference before the lock is released */
+typedef void(aws_dotnet_keyed_cache_on_hit_fn)(void *value, void *user_data);
+
+/* Writes the SHA-256 of each part's length and bytes to digest, so that parts that run together can't collide */
+int aws_dotnet_keyed_cache_digest(
+    const struct aws_byte_cursor *parts,
+    size_t part_count,
+    struct aws_byte_buf *digest);
+
+/* Replaces the LRU with an empty one of capacity entries, or disables the cache for 0, and resets the counters */
+int aws_dotnet_keyed_cache_configure(struct aws_dotnet_keyed_cache *cache, size_t capacity);
+
+/* Calls on_hit with the value for digest and returns true, or returns false and counts a miss */
+bool aws_dotnet_keyed_cache_find(
+    struct aws_dotnet_keyed_cache *cache,
+    struct aws_byte_cursor digest,
+    aws_dotnet_keyed_cache_on_hit_fn *on_hit,
+    void *user_data);
+
+/* Stores value for digest and takes ownership of it, or returns false, leaving it to the caller, if it can't */
+bool aws_dotnet_keyed_cache_put(struct aws_dotnet_keyed_cache *cache, struct aws_byte_cursor digest, void *value);
+
+void aws_dotnet_keyed_cache_get_stats(struct aws_dotnet_keyed_cache *cache, uint64_t *stats);
+
+#endif /* AWS_DOTNET_KEYED_CACHE_H */
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include "crt.h"
+#include "ecc_key_cache.h"
 #include "exports.h"
 #include "http_client.h"
 #include "stream.h"
@@ -13,6 +14,8 @@
 #include <aws/auth/signing_config.h>
 #include <aws/auth/signing_result.h>
 #include <aws/cal/ecc.h>
+#include <aws/common/atomics.h>
+#include <aws/common/date_time.h>
 #include <aws/common/string.h>
 #include <aws/http/request_response.h>
 #include <aws/io/stream.h>
@@ -49,6 +52,8 @@ struct aws_signing_config_native {
     int32_t signed_body_header;
 
     uint64_t expiration_in_seconds;
+
+    uint8_t cache_ecc_keys;
 };
 
 typedef void(DOTNET_CALL aws_dotnet_auth_on_signing_complete_fn)(
@@ -60,6 +65,37 @@ typedef void(DOTNET_CALL aws_dotnet_auth_on_signing_complete_fn)(
     struct aws_dotnet_http_header headers[],
     uint32_t header_count);
 
+/*
+ * Long lived signing config, built and validated once from an aws_signing_config_native and then reused for many
+ * signings, so that each signing only passes its timestamp and any per-request overrides.
+ */
+struct aws_dotnet_signing_config {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    /* Everything but the date, which comes with each signing */
+    struct aws_signing_config_aws config;
+    struct aws_credentials *credentials;
+    struct aws_string *region;
+    struct aws_string *service;
+    struct aws_string *signed_body_value;
+    aws_dotnet_auth_should_sign_header_fn *should_sign_header;
+};
+
+static void s_destroy_signing_config(struct aws_dotnet_signing_config *signing_config) {
+    aws_credentials_release(signing_config->credentials);
+    aws_string_destroy(signing_config->region);
+    aws_string_destroy(signing_config->service);
+    aws_string_destroy(signing_config->signed_body_value);
+
+    aws_mem_release(signing_config->allocator, signing_config);
+}
+
+static void s_signing_config_release(struct aws_dotnet_signing_config *signing_config) {
+    if (signing_config != NULL) {
+        aws_ref_count_release(&signing_config->ref_count);
+    }
+}
+
 struct aws_dotnet_signing_callback_state {
     struct aws_http_message *request;
     struct aws_input_stream *body_stream;
@@ -72,6 +108,8 @@ struct aws_dotnet_signing_callback_state {
     uint64_t callback_id;
     aws_dotnet_auth_on_signing_complete_fn *on_signing_complete;
     enum aws_signature_type signature_type;
+    /* Set when signing with a reusable signing config, which owns the strings config points to */
+    struct aws_dotnet_signing_config *signing_config;
 };
 
 static void s_destroy_signing_callback_state(struct aws_dotnet_signing_callback_state *callback_state) {
@@ -86,6 +124,7 @@ static void s_destroy_signing_callback_state(struct aws_dotnet_signing_callback_
     aws_string_destroy(callback_state->signed_body_value);
     aws_input_stream_release(callback_state->body_stream);
     aws_http_message_release(callback_state->request);
+    s_signing_config_release(callback_state->signing_config);
 
     aws_mem_release(aws_dotnet_get_allocator(), callback_state);
 }
@@ -108,6 +147,12 @@ static bool s_should_sign_header_adapter(const struct aws_byte_cursor *name, voi
     return callback_state->should_sign_header(name->ptr, (int32_t)name->len);
 }
 
+static bool s_signing_config_should_sign_header_adapter(const struct aws_byte_cursor *name, void *user_data) {
+    struct aws_dotnet_signing_config *signing_config = user_data;
+
+    return signing_config->should_sign_header(name->ptr, (int32_t)name->len);
+}
+
 static int s_initialize_signing_config(
     struct aws_signing_config_aws *config,
     struct aws_signing_config_native *dotnet_config,
@@ -146,6 +191,16 @@ static int s_initialize_signing_config(
         return AWS_OP_ERR;
     }
 
+    if (config->algorithm == AWS_SIGNING_ALGORITHM_V4_ASYMMETRIC && dotnet_config->cache_ecc_keys != 0) {
+        /* Sign with the cached ECC key rather than letting the signer derive it from the secret again */
+        struct aws_credentials *ecc_credentials = aws_dotnet_ecc_key_cache_get_credentials(callback_state->credentials);
+        aws_credentials_release(callback_state->credentials);
+        callback_state->credentials = ecc_credentials;
+        if (callback_state->credentials == NULL) {
+            return AWS_OP_ERR;
+        }
+    }
+
     config->signed_body_header = dotnet_config->signed_body_header;
 
     if (dotnet_config->signed_body_value != NULL) {
@@ -169,6 +224,97 @@ static int s_initialize_signing_config(
     return AWS_OP_SUCCESS;
 }
 
+AWS_DOTNET_API
+struct aws_dotnet_signing_config *aws_dotnet_signing_config_new(
+    struct aws_signing_config_native native_signing_config) {
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_dotnet_signing_config *signing_config =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_signing_config));
+    if (signing_config == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate signing config");
+        return NULL;
+    }
+
+    signing_config->allocator = allocator;
+    aws_ref_count_init(
+        &signing_config->ref_count, signing_config, (aws_simple_completion_callback *)s_destroy_signing_config);
+
+    /* Build the config the same way a single signing does, then take ownership of what it allocated */
+    struct aws_dotnet_signing_callback_state owned;
+    AWS_ZERO_STRUCT(owned);
+    int result = s_initialize_signing_config(&signing_config->config, &native_signing_config, &owned);
+
+    signing_config->credentials = owned.credentials;
+    signing_config->region = owned.region;
+    signing_config->service = owned.service;
+    signing_config->signed_body_value = owned.signed_body_value;
+    signing_config->should_sign_header = native_signing_config.should_sign_header;
+    signing_config->config.should_sign_header = NULL;
+    signing_config->config.should_sign_header_ud = NULL;
+
+    if (result == AWS_OP_SUCCESS && signing_config->config.algorithm == AWS_SIGNING_ALGORITHM_V4_ASYMMETRIC &&
+        aws_credentials_get_ecc_key_pair(signing_config->credentials) == NULL) {
+        /* Derive the SigV4a key once here rather than on every signing */
+        struct aws_credentials *ecc_credentials =
+            aws_credentials_new_ecc_from_aws_credentials(allocator, signing_config->credentials);
+        aws_credentials_release(signing_config->credentials);
+        signing_config->credentials = ecc_credentials;
+        signing_config->config.credentials = ecc_credentials;
+        if (ecc_credentials == NULL) {
+            result = AWS_OP_ERR;
+        }
+    }
+
+    if (result != AWS_OP_SUCCESS || aws_validate_aws_signing_config_aws(&signing_config->config)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Invalid signing config");
+        s_signing_config_release(signing_config);
+        return NULL;
+    }
+
+    return signing_config;
+}
+
+AWS_DOTNET_API void aws_dotnet_signing_config_destroy(struct aws_dotnet_signing_config *signing_config) {
+    s_signing_config_release(signing_config);
+}
+
+/* Fills config for one signing from a reusable signing config, the signing's timestamp and its overrides */
+static int s_initialize_signing_config_from_handle(
+    struct aws_signing_config_aws *config,
+    struct aws_dotnet_signing_config *signing_config,
+    int64_t milliseconds_since_epoch,
+    const char *signed_body_value,
+    uint64_t expiration_in_seconds,
+    struct aws_dotnet_signing_callback_state *callback_state) {
+
+    *config = signing_config->config;
+    aws_date_time_init_epoch_millis(&config->date, (uint64_t)milliseconds_since_epoch);
+
+    callback_state->signing_config = signing_config;
+    aws_ref_count_acquire(&signing_config->ref_count);
+
+    if (signed_body_value != NULL) {
+        callback_state->signed_body_value = aws_string_new_from_c_str(aws_dotnet_get_allocator(), signed_body_value);
+        if (callback_state->signed_body_value == NULL) {
+            return AWS_OP_ERR;
+        }
+
+        config->signed_body_value = aws_byte_cursor_from_string(callback_state->signed_body_value);
+    }
+
+    if (expiration_in_seconds != 0) {
+        config->expiration_in_seconds = expiration_in_seconds;
+    }
+
+    if (signing_config->should_sign_header != NULL) {
+        config->should_sign_header = s_signing_config_should_sign_header_adapter;
+        config->should_sign_header_ud = signing_config;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 static void s_complete_signing_exceptionally(struct aws_dotnet_signing_callback_state *callback_state, int error_code) {
     callback_state->on_signing_complete(callback_state->callback_id, error_code, NULL, 0, NULL, NULL, 0);
 }
@@ -529,6 +675,414 @@ on_error:
     on_signing_complete(callback_id, error_code, NULL, 0, NULL, NULL, 0);
 }
 
+/*
+ * Signs a continuation's signable with config and completes through on_signing_complete, releasing the continuation,
+ * if signing can't be started.
+ */
+static void s_sign_continuation(
+    struct aws_dotnet_signing_callback_state *continuation,
+    struct aws_signing_config_aws *config,
+    uint64_t callback_id,
+    aws_dotnet_auth_on_signing_complete_fn *on_signing_complete) {
+
+    if (continuation->original_request_signable != NULL &&
+        aws_sign_request_aws(
+            aws_dotnet_get_allocator(),
+            continuation->original_request_signable,
+            (struct aws_signing_config_base *)config,
+            s_aws_signing_complete,
+            continuation) == AWS_OP_SUCCESS) {
+        return;
+    }
+
+    s_destroy_signing_callback_state(continuation);
+
+    int error_code = aws_last_error();
+    if (error_code == AWS_ERROR_SUCCESS) {
+        error_code = AWS_ERROR_UNKNOWN;
+    }
+
+    on_signing_complete(callback_id, error_code, NULL, 0, NULL, NULL, 0);
+}
+
+AWS_DOTNET_API void aws_dotnet_auth_sign_http_request_with_config(
+    const char *method,
+    const char *uri,
+    struct aws_dotnet_http_header headers[],
+    uint32_t header_count,
+    struct aws_dotnet_stream_function_table body_stream_delegates,
+    struct aws_dotnet_signing_config *signing_config,
+    int64_t milliseconds_since_epoch,
+    const char *signed_body_value,
+    uint64_t expiration_in_seconds,
+    uint64_t callback_id,
+    aws_dotnet_auth_on_signing_complete_fn *on_signing_complete) {
+
+    struct aws_signing_config_aws config;
+    AWS_ZERO_STRUCT(config);
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_dotnet_signing_callback_state *continuation =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_signing_callback_state));
+    if (continuation == NULL) {
+        on_signing_complete(callback_id, aws_last_error(), NULL, 0, NULL, NULL, 0);
+        return;
+    }
+
+    continuation->callback_id = callback_id;
+    continuation->on_signing_complete = on_signing_complete;
+    continuation->signature_type = signing_config->config.signature_type;
+
+    if (s_initialize_signing_config_from_handle(
+            &config,
+            signing_config,
+            milliseconds_since_epoch,
+            signed_body_value,
+            expiration_in_seconds,
+            continuation) == AWS_OP_SUCCESS) {
+        continuation->request = aws_build_http_request(method, uri, headers, header_count, &body_stream_delegates);
+        if (continuation->request != NULL) {
+            continuation->original_request_signable = aws_signable_new_http_request(allocator, continuation->request);
+        }
+    }
+
+    s_sign_continuation(continuation, &config, callback_id, on_signing_complete);
+}
+
+AWS_DOTNET_API void aws_dotnet_auth_sign_canonical_request_with_config(
+    const char *canonical_request,
+    struct aws_dotnet_signing_config *signing_config,
+    int64_t milliseconds_since_epoch,
+    uint64_t callback_id,
+    aws_dotnet_auth_on_signing_complete_fn *on_signing_complete) {
+
+    struct aws_signing_config_aws config;
+    AWS_ZERO_STRUCT(config);
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_dotnet_signing_callback_state *continuation =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_signing_callback_state));
+    if (continuation == NULL) {
+        on_signing_complete(callback_id, aws_last_error(), NULL, 0, NULL, NULL, 0);
+        return;
+    }
+
+    continuation->callback_id = callback_id;
+    continuation->on_signing_complete = on_signing_complete;
+    continuation->signature_type = signing_config->config.signature_type;
+
+    if (s_initialize_signing_config_from_handle(
+            &config, signing_config, milliseconds_since_epoch, NULL, 0, continuation) == AWS_OP_SUCCESS) {
+        continuation->original_request_signable =
+            aws_signable_new_canonical_request(allocator, aws_byte_cursor_from_c_str(canonical_request));
+    }
+
+    s_sign_continuation(continuation, &config, callback_id, on_signing_complete);
+}
+
+AWS_DOTNET_API void aws_dotnet_auth_sign_chunk_with_config(
+    struct aws_dotnet_stream_function_table chunk_body_stream_delegates,
+    uint8_t *previous_signature,
+    uint32_t previous_signature_size,
+    struct aws_dotnet_signing_config *signing_config,
+    int64_t milliseconds_since_epoch,
+    uint64_t callback_id,
+    aws_dotnet_auth_on_signing_complete_fn *on_signing_complete) {
+
+    struct aws_byte_cursor previous_signature_cursor =
+        aws_byte_cursor_from_array(previous_signature, previous_signature_size);
+
+    struct aws_signing_config_aws config;
+    AWS_ZERO_STRUCT(config);
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_dotnet_signing_callback_state *continuation =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_signing_callback_state));
+    if (continuation == NULL) {
+        on_signing_complete(callback_id, aws_last_error(), NULL, 0, NULL, NULL, 0);
+        return;
+    }
+
+    continuation->callback_id = callback_id;
+    continuation->on_signing_complete = on_signing_complete;
+    continuation->signature_type = signing_config->config.signature_type;
+
+    if (s_initialize_signing_config_from_handle(
+            &config, signing_config, milliseconds_since_epoch, NULL, 0, continuation) == AWS_OP_SUCCESS) {
+        bool has_body = aws_stream_function_table_is_valid(&chunk_body_stream_delegates);
+        if (has_body) {
+            continuation->body_stream = aws_input_stream_new_dotnet(allocator, &chunk_body_stream_delegates);
+        }
+
+        if (!has_body || continuation->body_stream != NULL) {
+            continuation->original_request_signable =
+                aws_signable_new_chunk(allocator, continuation->body_stream, previous_signature_cursor);
+        }
+    }
+
+    s_sign_continuation(continuation, &config, callback_id, on_signing_complete);
+}
+
+/*
+ * Completes a batch signing. On success, results holds one record per request, in request order, of native endian
+ * fields: int32 error code, uint32 uri length, uri, uint32 signature length, signature, uint32 header count, then for
+ * each header uint32 name length, name, uint32 value length, value.  A failed request has an empty uri and signature
+ * and no headers.
+ */
+typedef void(DOTNET_CALL aws_dotnet_auth_on_batch_signing_complete_fn)(
+    uint64_t callback_id,
+    int32_t error_code,
+    const uint8_t *results,
+    uint64_t results_size);
+
+struct aws_dotnet_batch_signing_state {
+    struct aws_allocator *allocator;
+    struct aws_dotnet_signing_config *signing_config;
+    struct aws_signing_config_aws config;
+    /* Requests still signing, plus one held while they are being started */
+    struct aws_atomic_var pending;
+    uint32_t request_count;
+    /* One encoded result record per request */
+    struct aws_byte_buf *results;
+    uint64_t callback_id;
+    aws_dotnet_auth_on_batch_signing_complete_fn *on_batch_signing_complete;
+};
+
+struct aws_dotnet_batch_request_state {
+    struct aws_dotnet_batch_signing_state *batch;
+    uint32_t index;
+    struct aws_http_message *request;
+    struct aws_signable *signable;
+};
+
+static int s_append_batch_u32(struct aws_byte_buf *buffer, uint32_t value) {
+    struct aws_byte_cursor value_cursor = aws_byte_cursor_from_array(&value, sizeof(value));
+    return aws_byte_buf_append_dynamic(buffer, &value_cursor);
+}
+
+static int s_append_batch_bytes(struct aws_byte_buf *buffer, struct aws_byte_cursor bytes) {
+    if (s_append_batch_u32(buffer, (uint32_t)bytes.len)) {
+        return AWS_OP_ERR;
+    }
+
+    return aws_byte_buf_append_dynamic(buffer, &bytes);
+}
+
+static int s_encode_batch_signed_request(
+    struct aws_byte_buf *buffer,
+    const struct aws_http_message *request,
+    const struct aws_string *signature) {
+
+    struct aws_byte_cursor path;
+    AWS_ZERO_STRUCT(path);
+    aws_http_message_get_request_path(request, &path);
+
+    size_t header_count = aws_http_message_get_header_count(request);
+    if (s_append_batch_u32(buffer, AWS_ERROR_SUCCESS) || s_append_batch_bytes(buffer, path) ||
+        s_append_batch_bytes(buffer, aws_byte_cursor_from_string(signature)) ||
+        s_append_batch_u32(buffer, (uint32_t)header_count)) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t header_idx = 0; header_idx < header_count; ++header_idx) {
+        struct aws_http_header header;
+        AWS_ZERO_STRUCT(header);
+        aws_http_message_get_header(request, &header, header_idx);
+
+        if (s_append_batch_bytes(buffer, header.name) || s_append_batch_bytes(buffer, header.value)) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_encode_batch_failed_request(struct aws_byte_buf *buffer, int error_code) {
+    buffer->len = 0;
+    s_append_batch_u32(buffer, (uint32_t)(error_code != AWS_ERROR_SUCCESS ? error_code : AWS_ERROR_UNKNOWN));
+    s_append_batch_u32(buffer, 0);
+    s_append_batch_u32(buffer, 0);
+    s_append_batch_u32(buffer, 0);
+}
+
+static void s_destroy_batch_signing_state(struct aws_dotnet_batch_signing_state *batch) {
+    if (batch->results != NULL) {
+        for (uint32_t i = 0; i < batch->request_count; ++i) {
+            aws_byte_buf_clean_up(&batch->results[i]);
+        }
+        aws_mem_release(batch->allocator, batch->results);
+    }
+
+    s_signing_config_release(batch->signing_config);
+    aws_mem_release(batch->allocator, batch);
+}
+
+static void s_batch_request_done(struct aws_dotnet_batch_signing_state *batch) {
+    if (aws_atomic_fetch_sub(&batch->pending, 1) != 1) {
+        return;
+    }
+
+    size_t results_size = 0;
+    for (uint32_t i = 0; i < batch->request_count; ++i) {
+        results_size += batch->results[i].len;
+    }
+
+    struct aws_byte_buf results;
+    if (aws_byte_buf_init(&results, batch->allocator, results_size)) {
+        batch->on_batch_signing_complete(batch->callback_id, aws_last_error(), NULL, 0);
+        goto done;
+    }
+
+    for (uint32_t i = 0; i < batch->request_count; ++i) {
+        struct aws_byte_cursor result = aws_byte_cursor_from_buf(&batch->results[i]);
+        aws_byte_buf_append(&results, &result);
+    }
+
+    batch->on_batch_signing_complete(batch->callback_id, AWS_ERROR_SUCCESS, results.buffer, results.len);
+    aws_byte_buf_clean_up(&results);
+
+done:
+    s_destroy_batch_signing_state(batch);
+}
+
+static void s_destroy_batch_request_state(struct aws_dotnet_batch_request_state *request_state) {
+    struct aws_dotnet_batch_signing_state *batch = request_state->batch;
+
+    aws_signable_destroy(request_state->signable);
+    aws_http_message_release(request_state->request);
+    aws_mem_release(batch->allocator, request_state);
+
+    s_batch_request_done(batch);
+}
+
+static void s_on_batch_request_signed(struct aws_signing_result *result, int error_code, void *user_data) {
+    struct aws_dotnet_batch_request_state *request_state = user_data;
+    struct aws_dotnet_batch_signing_state *batch = request_state->batch;
+    struct aws_byte_buf *record = &batch->results[request_state->index];
+
+    struct aws_string *signature = NULL;
+    if (result != NULL && error_code == AWS_ERROR_SUCCESS &&
+        aws_apply_signing_result_to_http_request(request_state->request, batch->allocator, result) ==
+            AWS_OP_SUCCESS) {
+        aws_signing_result_get_property(result, g_aws_signature_property_name, &signature);
+        if (signature == NULL) {
+            aws_raise_error(AWS_ERROR_INVALID_STATE);
+        } else if (s_encode_batch_signed_request(record, request_state->request, signature) == AWS_OP_SUCCESS) {
+            goto done;
+        }
+        error_code = aws_last_error();
+    } else if (error_code == AWS_ERROR_SUCCESS) {
+        error_code = aws_last_error();
+    }
+
+    s_encode_batch_failed_request(record, error_code);
+
+done:
+    s_destroy_batch_request_state(request_state);
+}
+
+/* Starts signing one request of a batch, recording its failure if it can't be started */
+static void s_sign_batch_request(
+    struct aws_dotnet_batch_signing_state *batch,
+    uint32_t index,
+    const char *method,
+    const char *uri,
+    struct aws_dotnet_http_header headers[],
+    uint32_t header_count) {
+
+    aws_atomic_fetch_add(&batch->pending, 1);
+
+    struct aws_dotnet_batch_request_state *request_state =
+        aws_mem_calloc(batch->allocator, 1, sizeof(struct aws_dotnet_batch_request_state));
+    if (request_state == NULL) {
+        s_encode_batch_failed_request(&batch->results[index], aws_last_error());
+        s_batch_request_done(batch);
+        return;
+    }
+
+    request_state->batch = batch;
+    request_state->index = index;
+    request_state->request = aws_build_http_request(method, uri, headers, header_count, NULL);
+    if (request_state->request != NULL) {
+        request_state->signable = aws_signable_new_http_request(batch->allocator, request_state->request);
+    }
+
+    if (request_state->signable == NULL ||
+        aws_sign_request_aws(
+            batch->allocator,
+            request_state->signable,
+            (struct aws_signing_config_base *)&batch->config,
+            s_on_batch_request_signed,
+            request_state)) {
+        s_encode_batch_failed_request(&batch->results[index], aws_last_error());
+        s_destroy_batch_request_state(request_state);
+    }
+}
+
+/*
+ * Signs request_count bodyless requests with one signing config and timestamp, and completes once with every
+ * result.  headers holds each request's headers in turn, header_counts[i] of them for request i.
+ */
+AWS_DOTNET_API void aws_dotnet_auth_sign_http_requests_with_config(
+    uint32_t request_count,
+    const char *methods[],
+    const char *uris[],
+    struct aws_dotnet_http_header headers[],
+    uint32_t header_counts[],
+    struct aws_dotnet_signing_config *signing_config,
+    int64_t milliseconds_since_epoch,
+    uint64_t callback_id,
+    aws_dotnet_auth_on_batch_signing_complete_fn *on_batch_signing_complete) {
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_dotnet_batch_signing_state *batch =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_batch_signing_state));
+    if (batch == NULL) {
+        on_batch_signing_complete(callback_id, aws_last_error(), NULL, 0);
+        return;
+    }
+
+    batch->allocator = allocator;
+    batch->signing_config = signing_config;
+    aws_ref_count_acquire(&signing_config->ref_count);
+    batch->request_count = request_count;
+    batch->callback_id = callback_id;
+    batch->on_batch_signing_complete = on_batch_signing_complete;
+    aws_atomic_init_int(&batch->pending, 1);
+
+    batch->results = aws_mem_calloc(allocator, request_count > 0 ? request_count : 1, sizeof(struct aws_byte_buf));
+    if (batch->results == NULL) {
+        on_batch_signing_complete(callback_id, aws_last_error(), NULL, 0);
+        s_destroy_batch_signing_state(batch);
+        return;
+    }
+
+    for (uint32_t i = 0; i < request_count; ++i) {
+        aws_byte_buf_init(&batch->results[i], allocator, 256);
+    }
+
+    /* Shared by every request in the batch */
+    batch->config = signing_config->config;
+    aws_date_time_init_epoch_millis(&batch->config.date, (uint64_t)milliseconds_since_epoch);
+    if (signing_config->should_sign_header != NULL) {
+        batch->config.should_sign_header = s_signing_config_should_sign_header_adapter;
+        batch->config.should_sign_header_ud = signing_config;
+    }
+
+    uint32_t header_offset = 0;
+    for (uint32_t i = 0; i < request_count; ++i) {
+        s_sign_batch_request(batch, i, methods[i], uris[i], headers + header_offset, header_counts[i]);
+        header_offset += header_counts[i];
+    }
+
+    /* Release the hold taken at creation, completing the batch if every request is already done */
+    s_batch_request_done(batch);
+}
+
 AWS_DOTNET_API bool aws_dotnet_auth_verify_v4a_canonical_signing(
     const char *canonical_request,
     struct aws_signing_config_native native_signing_config,
@@ -0,0 +1,150 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "signing_key_cache.h"
+#include "crt.h"
+#include "exports.h"
+#include "keyed_cache.h"
+
+#include <aws/cal/hash.h>
+#include <aws/cal/hmac.h>
+#include <aws/common/date_time.h>
+
+static void s_destroy_signing_key(void *key) {
+    aws_secure_zero(key, AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE);
+    aws_mem_release(aws_dotnet_get_allocator(), key);
+}
+
+/* Digest of access key, secret, date, region and service -> AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE byte key */
+static struct aws_dotnet_keyed_cache s_cache = AWS_DOTNET_KEYED_CACHE_INIT(0, s_destroy_signing_key);
+
+AWS_DOTNET_API
+void aws_dotnet_auth_signing_key_cache_configure(uint32_t capacity) {
+    if (aws_dotnet_keyed_cache_configure(&s_cache, capacity)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to create signing key cache");
+    }
+}
+
+/* stats has room for AWS_DOTNET_KEYED_CACHE_STAT_COUNT values */
+AWS_DOTNET_API
+void aws_dotnet_auth_signing_key_cache_get_stats(uint64_t *stats) {
+    aws_dotnet_keyed_cache_get_stats(&s_cache, stats);
+}
+
+void aws_dotnet_signing_key_cache_clean_up(void) {
+    aws_dotnet_keyed_cache_configure(&s_cache, 0);
+}
+
+/* kSigning = HMAC(HMAC(HMAC(HMAC("AWS4" + secret, date), region), service), "aws4_request") */
+static int s_derive_signing_key(
+    struct aws_byte_cursor secret_access_key,
+    struct aws_byte_cursor date,
+    struct aws_byte_cursor region,
+    struct aws_byte_cursor service,
+    uint8_t key[AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE]) {
+
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+    int result = AWS_OP_ERR;
+
+    struct aws_byte_buf secret;
+    if (aws_byte_buf_init(&secret, allocator, secret_access_key.len + 4)) {
+        return AWS_OP_ERR;
+    }
+    struct aws_byte_cursor prefix = aws_byte_cursor_from_c_str("AWS4");
+    aws_byte_buf_append(&secret, &prefix);
+    aws_byte_buf_append(&secret, &secret_access_key);
+
+    struct aws_byte_cursor scope[] = {date, region, service, aws_byte_cursor_from_c_str("aws4_request")};
+    uint8_t current[AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE];
+    struct aws_byte_cursor hmac_key = aws_byte_cursor_from_buf(&secret);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(scope); ++i) {
+        struct aws_byte_buf output = aws_byte_buf_from_empty_array(key, AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE);
+        if (aws_sha256_hmac_compute(allocator, &hmac_key, &scope[i], &output, 0)) {
+            goto done;
+        }
+        memcpy(current, key, sizeof(current));
+        hmac_key = aws_byte_cursor_from_array(current, sizeof(current));
+    }
+    result = AWS_OP_SUCCESS;
+
+done:
+    aws_byte_buf_clean_up_secure(&secret);
+    aws_secure_zero(current, sizeof(current));
+    return result;
+}
+
+static void s_copy_signing_key(void *cached, void *key) {
+    memcpy(key, cached, AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE);
+}
+
+/*
+ * Writes the SigV4 signing key for the scope to key, either from the cache or by deriving it (and caching it, if the
+ * cache is enabled). date is the YYYYMMDD date of the signature.
+ */
+static int s_get_signing_key(
+    struct aws_byte_cursor access_key_id,
+    struct aws_byte_cursor secret_access_key,
+    struct aws_byte_cursor date,
+    struct aws_byte_cursor region,
+    struct aws_byte_cursor service,
+    uint8_t key[AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE]) {
+
+    struct aws_byte_cursor identity[] = {access_key_id, secret_access_key, date, region, service};
+    uint8_t digest_storage[AWS_SHA256_LEN];
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    if (aws_dotnet_keyed_cache_digest(identity, AWS_ARRAY_SIZE(identity), &digest)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_byte_cursor digest_cursor = aws_byte_cursor_from_buf(&digest);
+    if (aws_dotnet_keyed_cache_find(&s_cache, digest_cursor, s_copy_signing_key, key)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    /* derive outside the lock, a concurrent miss for the same scope just replaces an identical key */
+    if (s_derive_signing_key(secret_access_key, date, region, service, key)) {
+        return AWS_OP_ERR;
+    }
+
+    uint8_t *cached_key = aws_mem_acquire(aws_dotnet_get_allocator(), AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE);
+    memcpy(cached_key, key, AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE);
+    if (!aws_dotnet_keyed_cache_put(&s_cache, digest_cursor, cached_key)) {
+        s_destroy_signing_key(cached_key);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Writes the SigV4 signing key for the credentials, the UTC date of milliseconds_since_epoch, region and service to
+ * key, which has room for AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE bytes.
+ */
+AWS_DOTNET_API
+void aws_dotnet_auth_signing_key_cache_get_key(
+    const uint8_t *access_key_id,
+    uint32_t access_key_id_length,
+    const uint8_t *secret_access_key,
+    uint32_t secret_access_key_length,
+    int64_t milliseconds_since_epoch,
+    const char *region,
+    const char *service,
+    uint8_t *key) {
+
+    struct aws_date_time timestamp;
+    aws_date_time_init_epoch_millis(&timestamp, (uint64_t)milliseconds_since_epoch);
+
+    uint8_t date_storage[AWS_DATE_TIME_STR_MAX_BASIC_LEN];
+    struct aws_byte_buf date = aws_byte_buf_from_empty_array(date_storage, sizeof(date_storage));
+    if (aws_date_time_to_utc_time_short_str(&timestamp, AWS_DATE_FORMAT_ISO_8601_BASIC, &date) ||
+        s_get_signing_key(
+            aws_byte_cursor_from_array(access_key_id, access_key_id_length),
+            aws_byte_cursor_from_array(secret_access_key, secret_access_key_length),
+            aws_byte_cursor_from_buf(&date),
+            aws_byte_cursor_from_c_str(region),
+            aws_byte_cursor_from_c_str(service),
+            key)) {
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to derive signing key");
+    }
+}
@@ -0,0 +1,19 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_DOTNET_SIGNING_KEY_CACHE_H
+#define AWS_DOTNET_SIGNING_KEY_CACHE_H
+
+#include <aws/common/common.h>
+
+#define AWS_DOTNET_SIGV4_SIGNING_KEY_SIZE 32
+
+/*
+ * Process wide, bounded LRU cache of derived SigV4 signing keys, keyed by a digest of credentials, date, region and
+ * service. It is disabled until aws_dotnet_auth_signing_key_cache_configure is called with a non-zero capacity.
+ */
+void aws_dotnet_signing_key_cache_clean_up(void);
+
+#endif /* AWS_DOTNET_SIGNING_KEY_CACHE_H */
@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include "crt.h"
+#include "exports.h"
+
+#include <aws/auth/signing.h>
+#include <aws/cal/ecc.h>
+
+/*
+ * A SigV4a public key, parsed and validated once and then used for any number of signature verifications.
+ * Verification only reads the key, so one verifier may be used from several threads at once.
+ */
+struct aws_dotnet_sigv4a_verifier {
+    struct aws_allocator *allocator;
+    struct aws_ecc_key_pair *ecc_key;
+};
+
+AWS_DOTNET_API
+struct aws_dotnet_sigv4a_verifier *aws_dotnet_auth_sigv4a_verifier_new(const char *ecc_pub_x, const char *ecc_pub_y) {
+    struct aws_allocator *allocator = aws_dotnet_get_allocator();
+
+    struct aws_ecc_key_pair *ecc_key = aws_ecc_key_new_from_hex_coordinates(
+        allocator, AWS_CAL_ECDSA_P256, aws_byte_cursor_from_c_str(ecc_pub_x), aws_byte_cursor_from_c_str(ecc_pub_y));
+    if (ecc_key == NULL) {
+        aws_dotnet_throw_exception(aws_last_error(), "Invalid SigV4a public key");
+        return NULL;
+    }
+
+    struct aws_dotnet_sigv4a_verifier *verifier =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_dotnet_sigv4a_verifier));
+    if (verifier == NULL) {
+        aws_ecc_key_pair_release(ecc_key);
+        aws_dotnet_throw_exception(aws_last_error(), "Unable to allocate SigV4a verifier");
+        return NULL;
+    }
+
+    verifier->allocator = allocator;
+    verifier->ecc_key = ecc_key;
+
+    return verifier;
+}
+
+AWS_DOTNET_API
+void aws_dotnet_auth_sigv4a_verifier_destroy(struct aws_dotnet_sigv4a_verifier *verifier) {
+    if (verifier == NULL) {
+        return;
+    }
+
+    aws_ecc_key_pair_release(verifier->ecc_key);
+    aws_mem_release(verifier->allocator, verifier);
+}
+
+static bool s_verify(
+    struct aws_dotnet_sigv4a_verifier *verifier,
+    struct aws_byte_cursor string_to_sign,
+    struct aws_byte_cursor signature) {
+
+    return aws_validate_v4a_authorization_value(verifier->allocator, verifier->ecc_key, string_to_sign, signature) ==
+           AWS_OP_SUCCESS;
+}
+
+/* string_to_sign is UTF-8 and not NUL-terminated */
+AWS_DOTNET_API
+bool aws_dotnet_auth_sigv4a_verifier_verify(
+    struct aws_dotnet_sigv4a_verifier *verifier,
+    const uint8_t *string_to_sign,
+    uint32_t string_to_sign_size,
+    uint8_t *signature,
+    uint32_t signature_size) {
+
+    return s_verify(
+        verifier,
+        aws_byte_cursor_from_array(string_to_sign, string_to_sign_size),
+        aws_byte_cursor_from_array(signature, signature_size));
+}
+
+/*
+ * Verifies records [start, start + count).  String to sign i is strings_to_sign[string_offsets[i],
+ * string_offsets[i] + string_lengths[i]) and its signature is likewise taken from signatures; results[i] is set to
+ * 1 if the signature is valid and 0 otherwise.  Distinct ranges of one batch may be verified concurrently.
+ */
+AWS_DOTNET_API
+void aws_dotnet_auth_sigv4a_verifier_verify_batch(
+    struct aws_dotnet_sigv4a_verifier *verifier,
+    const uint8_t *strings_to_sign,
+    const int32_t *string_offsets,
+    const int32_t *string_lengths,
+    const uint8_t *signatures,
+    const int32_t *signature_offsets,
+    const int32_t *signature_lengths,
+    uint32_t start,
+    uint32_t count,
+    uint8_t *results) {
+
+    for (uint32_t i = start; i < start + count; ++i) {
+        struct aws_byte_cursor string_to_sign =
+            aws_byte_cursor_from_array(strings_to_sign + string_offsets[i], (size_t)string_lengths[i]);
+        struct aws_byte_cursor signature =
+            aws_byte_cursor_from_array(signatures + signature_offsets[i], (size_t)signature_lengths[i]);
+
+        results[i] = s_verify(verifier, string_to_sign, signature) ? 1 : 0;
+    }
+}
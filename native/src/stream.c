@@ -7,8 +7,11 @@
 #include "crt.h"
 #include "exports.h"
 
+#include <aws/common/file.h>
 #include <aws/io/stream.h>
 
+#include <stdio.h>
+
 struct aws_input_stream_dotnet_impl {
     struct aws_input_stream base;
     struct aws_allocator *allocator;
@@ -34,6 +37,7 @@ static int s_aws_input_stream_dotnet_read(struct aws_input_stream *stream, struc
     uint64_t buf_size = dest->capacity - dest->len;
     uint8_t *buf_ptr = dest->buffer + dest->len;
     uint64_t bytes_written = 0;
+    /* The managed side writes directly into the unused tail of dest */
     impl->state = impl->delegates.read(buf_ptr, buf_size, &bytes_written);
     AWS_FATAL_ASSERT(bytes_written <= buf_size && "Buffer overflow detected streaming outgoing body");
     dest->len += (size_t)bytes_written;
@@ -51,10 +55,13 @@ static int s_aws_input_stream_dotnet_get_status(struct aws_input_stream *stream,
 }
 
 static int s_aws_input_stream_dotnet_get_length(struct aws_input_stream *stream, int64_t *out_length) {
-    (void)stream;
-    (void)out_length;
+    struct aws_input_stream_dotnet_impl *impl = AWS_CONTAINER_OF(stream, struct aws_input_stream_dotnet_impl, base);
+
+    if (impl->delegates.get_length == NULL || !impl->delegates.get_length(out_length)) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
 
-    return AWS_OP_ERR;
+    return AWS_OP_SUCCESS;
 }
 
 static void s_aws_input_stream_dotnet_destroy(struct aws_input_stream_dotnet_impl *impl) {
@@ -68,11 +75,163 @@ static struct aws_input_stream_vtable s_aws_input_stream_dotnet_vtable = {
     .get_length = s_aws_input_stream_dotnet_get_length,
 };
 
+/* A range of a file, read directly by native code */
+struct aws_input_stream_dotnet_file_impl {
+    struct aws_input_stream base;
+    struct aws_allocator *allocator;
+
+    FILE *file;
+    /* The range within the file, and the position of the stream within that range */
+    int64_t offset;
+    int64_t length;
+    int64_t position;
+};
+
+static int s_aws_input_stream_dotnet_file_seek(
+    struct aws_input_stream *stream,
+    aws_off_t offset,
+    enum aws_stream_seek_basis basis) {
+
+    struct aws_input_stream_dotnet_file_impl *impl =
+        AWS_CONTAINER_OF(stream, struct aws_input_stream_dotnet_file_impl, base);
+
+    int64_t position = basis == AWS_SSB_BEGIN ? (int64_t)offset : impl->length + (int64_t)offset;
+    if (position < 0 || position > impl->length) {
+        return aws_raise_error(AWS_IO_STREAM_INVALID_SEEK_POSITION);
+    }
+
+    if (aws_fseek(impl->file, impl->offset + position, SEEK_SET)) {
+        return AWS_OP_ERR;
+    }
+
+    impl->position = position;
+    return AWS_OP_SUCCESS;
+}
+
+static int s_aws_input_stream_dotnet_file_read(struct aws_input_stream *stream, struct aws_byte_buf *dest) {
+    struct aws_input_stream_dotnet_file_impl *impl =
+        AWS_CONTAINER_OF(stream, struct aws_input_stream_dotnet_file_impl, base);
+
+    size_t to_read = dest->capacity - dest->len;
+    if ((uint64_t)to_read > (uint64_t)(impl->length - impl->position)) {
+        to_read = (size_t)(impl->length - impl->position);
+    }
+
+    if (to_read == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t bytes_read = fread(dest->buffer + dest->len, 1, to_read, impl->file);
+    if (bytes_read == 0) {
+        /* Either a read error, or the file has shrunk since the stream was created */
+        return aws_raise_error(AWS_IO_STREAM_READ_FAILED);
+    }
+
+    dest->len += bytes_read;
+    impl->position += (int64_t)bytes_read;
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_aws_input_stream_dotnet_file_get_status(
+    struct aws_input_stream *stream,
+    struct aws_stream_status *status) {
+    struct aws_input_stream_dotnet_file_impl *impl =
+        AWS_CONTAINER_OF(stream, struct aws_input_stream_dotnet_file_impl, base);
+
+    status->is_end_of_stream = impl->position == impl->length;
+    status->is_valid = ferror(impl->file) == 0;
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_aws_input_stream_dotnet_file_get_length(struct aws_input_stream *stream, int64_t *out_length) {
+    struct aws_input_stream_dotnet_file_impl *impl =
+        AWS_CONTAINER_OF(stream, struct aws_input_stream_dotnet_file_impl, base);
+
+    *out_length = impl->length;
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_aws_input_stream_dotnet_file_destroy(struct aws_input_stream_dotnet_file_impl *impl) {
+    fclose(impl->file);
+    aws_mem_release(impl->allocator, impl);
+}
+
+static struct aws_input_stream_vtable s_aws_input_stream_dotnet_file_vtable = {
+    .seek = s_aws_input_stream_dotnet_file_seek,
+    .read = s_aws_input_stream_dotnet_file_read,
+    .get_status = s_aws_input_stream_dotnet_file_get_status,
+    .get_length = s_aws_input_stream_dotnet_file_get_length,
+};
+
+static struct aws_input_stream *s_aws_input_stream_new_dotnet_file(
+    struct aws_allocator *allocator,
+    const char *path,
+    int64_t offset,
+    int64_t length) {
+
+    FILE *file = aws_fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    int64_t file_size = 0;
+    if (aws_file_get_length(file, &file_size)) {
+        goto on_error;
+    }
+
+    if (offset < 0 || offset > file_size) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto on_error;
+    }
+
+    if (length == AWS_DOTNET_STREAM_FILE_TO_END) {
+        length = file_size - offset;
+    } else if (length < 0 || length > file_size - offset) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto on_error;
+    }
+
+    if (aws_fseek(file, offset, SEEK_SET)) {
+        goto on_error;
+    }
+
+    struct aws_input_stream_dotnet_file_impl *impl =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_input_stream_dotnet_file_impl));
+
+    impl->allocator = allocator;
+    impl->base.vtable = &s_aws_input_stream_dotnet_file_vtable;
+
+    impl->file = file;
+    impl->offset = offset;
+    impl->length = length;
+    impl->position = 0;
+
+    aws_ref_count_init(
+        &impl->base.ref_count, impl, (aws_simple_completion_callback *)s_aws_input_stream_dotnet_file_destroy);
+
+    return &impl->base;
+
+on_error:
+
+    fclose(file);
+
+    return NULL;
+}
+
 struct aws_input_stream *aws_input_stream_new_dotnet(
     struct aws_allocator *allocator,
     struct aws_dotnet_stream_function_table *function_table) {
 
     AWS_FATAL_ASSERT(aws_stream_function_table_is_valid(function_table));
+    AWS_FATAL_ASSERT(!aws_stream_function_table_is_async(function_table));
+
+    if (aws_stream_function_table_is_file(function_table)) {
+        return s_aws_input_stream_new_dotnet_file(
+            allocator, function_table->file_path, function_table->file_offset, function_table->file_length);
+    }
 
     struct aws_input_stream_dotnet_impl *impl =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_input_stream_dotnet_impl));
@@ -94,6 +253,14 @@ bool aws_stream_function_table_is_valid(struct aws_dotnet_stream_function_table
         return false;
     }
 
+    if (aws_stream_function_table_is_file(function_table)) {
+        return true;
+    }
+
+    if (function_table->async_read != NULL) {
+        return true;
+    }
+
     if (function_table->read == NULL) {
         return false;
     }
@@ -104,3 +271,11 @@ bool aws_stream_function_table_is_valid(struct aws_dotnet_stream_function_table
 
     return true;
 }
+
+bool aws_stream_function_table_is_file(struct aws_dotnet_stream_function_table *function_table) {
+    return function_table != NULL && function_table->file_path != NULL;
+}
+
+bool aws_stream_function_table_is_async(struct aws_dotnet_stream_function_table *function_table) {
+    return function_table != NULL && function_table->file_path == NULL && function_table->async_read != NULL;
+}
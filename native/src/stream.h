@@ -10,8 +10,14 @@
 
 #include "crt.h"
 
+struct aws_async_input_stream;
+struct aws_dotnet_async_body;
+struct aws_http_stream;
 struct aws_input_stream;
 
+/* Size of the buffer each async read of a body reads into */
+#define AWS_DOTNET_ASYNC_STREAM_BUFFER_SIZE (64 * 1024)
+
 enum aws_stream_state {
     STREAM_STATE_IN_PROGRESS,
     STREAM_STATE_DONE,
@@ -19,16 +25,67 @@ enum aws_stream_state {
 
 typedef int(DOTNET_CALL aws_dotnet_stream_read_fn)(uint8_t *buffer, uint64_t buffer_size, uint64_t *bytes_written);
 typedef bool(DOTNET_CALL aws_dotnet_stream_seek_fn)(int64_t offset, int32_t basis);
+typedef bool(DOTNET_CALL aws_dotnet_stream_get_length_fn)(int64_t *length);
+/* Starts a read into buffer, which managed code finishes with aws_dotnet_async_input_stream_complete_read(stream) */
+typedef void(DOTNET_CALL aws_dotnet_stream_async_read_fn)(
+    struct aws_async_input_stream *stream,
+    uint8_t *buffer,
+    uint64_t buffer_size);
+
+/* Passed as file_length to send the file from file_offset to its end */
+#define AWS_DOTNET_STREAM_FILE_TO_END (-1)
 
 struct aws_dotnet_stream_function_table {
     aws_dotnet_stream_read_fn *read;
     aws_dotnet_stream_seek_fn *seek;
+    /* Optional; returns false if the length is not known, e.g. for a stream that can't seek */
+    aws_dotnet_stream_get_length_fn *get_length;
+    /*
+     * If set, the body is read with async reads, never blocking the event loop, and can't seek. Such a body is sent
+     * with aws_dotnet_async_body rather than as an aws_input_stream.
+     */
+    aws_dotnet_stream_async_read_fn *async_read;
+    /*
+     * If file_path is set, the stream is [file_offset, file_offset + file_length) of that file, read by native code
+     * without calling read or seek
+     */
+    const char *file_path;
+    int64_t file_offset;
+    int64_t file_length;
 };
 
+/*
+ * Creates a stream that calls back into managed code, or reads the file range of a file backed table. The function
+ * table, including file_path, need not outlive the call. Returns NULL, with an error raised, if the file can't be
+ * opened or the range is not within it. Not for tables with async_read set.
+ */
 struct aws_input_stream *aws_input_stream_new_dotnet(
     struct aws_allocator *allocator,
     struct aws_dotnet_stream_function_table *function_table);
 
+/* Creates the body for a table with async_read set, which has a reference held by the caller */
+struct aws_dotnet_async_body *aws_dotnet_async_body_new(
+    struct aws_allocator *allocator,
+    struct aws_dotnet_stream_function_table *function_table);
+
+/*
+ * Starts sending the body on stream, which has been activated: each async read is written to the stream as soon as it
+ * finishes, as an HTTP/1.1 chunk or an HTTP/2 DATA frame. The request must have been made with Transfer-Encoding:
+ * chunked on HTTP/1.1, or with http2_use_manual_data_writes on HTTP/2. A failed read cancels the stream. The body
+ * takes over the caller's reference to stream, and releases it once the body is released and its last read or write
+ * has finished.
+ */
+void aws_dotnet_async_body_start(struct aws_dotnet_async_body *body, struct aws_http_stream *stream);
+
+/* Whether aws_dotnet_async_body_start has been called, so the body owns the stream */
+bool aws_dotnet_async_body_is_sending(struct aws_dotnet_async_body *body);
+
+void aws_dotnet_async_body_release(struct aws_dotnet_async_body *body);
+
+bool aws_stream_function_table_is_file(struct aws_dotnet_stream_function_table *function_table);
+
+bool aws_stream_function_table_is_async(struct aws_dotnet_stream_function_table *function_table);
+
 bool aws_stream_function_table_is_valid(struct aws_dotnet_stream_function_table *function_table);
 
 #endif /* AWS_DOTNET_STREAM_H */
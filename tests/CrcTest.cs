@@ -3,8 +3,11 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 using System;
+using System.IO;
+using System.Runtime.InteropServices;
 using Xunit;
 
+using Aws.Crt;
 using Aws.Crt.Checksums;
 
 namespace tests
@@ -125,5 +128,137 @@ namespace tests
             ulong expected = 0xCF3473434D4ECF3B;
             Assert.Equal(expected, res);
         }
+        [Fact]
+        public void TestCrc32Slice()
+        {
+            byte[] values = new byte[48];
+            for (byte i = 0; i < 32; i++) {
+                values[i + 8] = i;
+            }
+            uint res = Crc.crc32(values, 8, 32);
+            uint expected = 0x91267E8A;
+            Assert.Equal(expected, res);
+        }
+        [Fact]
+        public void TestCrc32cSlice()
+        {
+            byte[] values = new byte[48];
+            for (byte i = 0; i < 32; i++) {
+                values[i + 8] = i;
+            }
+            uint res = Crc.crc32c(values, 8, 32);
+            uint expected = 0x46DD794E;
+            Assert.Equal(expected, res);
+        }
+        [Fact]
+        public void TestCrc64NVMESlice()
+        {
+            byte[] zeroes = new byte[40];
+            zeroes[0] = 0xff;
+            zeroes[39] = 0xff;
+            ulong res = Crc.crc64nvme(zeroes, 4, 32);
+            ulong expected = 0xCF3473434D4ECF3B;
+            Assert.Equal(expected, res);
+        }
+        [Fact]
+        public void TestCrcSliceOutOfRange()
+        {
+            byte[] values = new byte[32];
+            Assert.Throws<ArgumentOutOfRangeException>(() => Crc.crc32(values, 16, 17));
+            Assert.Throws<ArgumentOutOfRangeException>(() => Crc.crc32c(values, -1, 4));
+            Assert.Throws<ArgumentNullException>(() => Crc.crc64nvme(null, 0, 0));
+        }
+        [Fact]
+        public void TestCrc32cNativeMemory()
+        {
+            IntPtr buffer = Marshal.AllocHGlobal(32);
+            try {
+                for (byte i = 0; i < 32; i++) {
+                    Marshal.WriteByte(buffer, i, i);
+                }
+                uint res = Crc.crc32c(buffer, 32);
+                uint expected = 0x46DD794E;
+                Assert.Equal(expected, res);
+            } finally {
+                Marshal.FreeHGlobal(buffer);
+            }
+        }
+        [Fact]
+        public void TestCrcCombine()
+        {
+            byte[] values = new byte[32];
+            for (byte i = 0; i < 32; i++) {
+                values[i] = i;
+            }
+            Assert.Equal(0x91267E8Au, Crc.crc32Combine(Crc.crc32(values, 0, 10), Crc.crc32(values, 10, 22), 22));
+            Assert.Equal(0x46DD794Eu, Crc.crc32cCombine(Crc.crc32c(values, 0, 10), Crc.crc32c(values, 10, 22), 22));
+            Assert.Equal(Crc.crc64nvme(values), Crc.crc64nvmeCombine(Crc.crc64nvme(values, 0, 31), Crc.crc64nvme(values, 31, 1), 1));
+            Assert.Equal(Crc.crc32c(values), Crc.crc32cCombine(Crc.crc32c(values), 0, 0));
+        }
+        [Fact]
+        public void TestCrcParallelLargeBuffer()
+        {
+            byte[] zeroes = new byte[25 * (1 << 20)];
+            Assert.Equal(0x72103906u, Crc.crc32Parallel(zeroes, 3));
+            Assert.Equal(0xfb5b991du, Crc.crc32cParallel(zeroes, 3));
+            Assert.Equal(Crc.crc64nvme(zeroes), Crc.crc64nvmeParallel(zeroes, 3));
+        }
+        [Fact]
+        public void TestCrcParallelFile()
+        {
+            byte[] data = new byte[17 * (1 << 20) + 3];
+            new Random(42).NextBytes(data);
+            string path = Path.GetTempFileName();
+            try {
+                File.WriteAllBytes(path, data);
+                Assert.Equal(Crc.crc32(data), Crc.crc32Parallel(path, 2));
+                Assert.Equal(Crc.crc32c(data), Crc.crc32cParallel(path, 4));
+                Assert.Equal(Crc.crc64nvme(data), Crc.crc64nvmeParallel(path));
+            } finally {
+                File.Delete(path);
+            }
+        }
+        [Fact]
+        public void TestCrcFile()
+        {
+            byte[] data = new byte[5 * (1 << 20) + 7];
+            new Random(7).NextBytes(data);
+            string path = Path.GetTempFileName();
+            try {
+                File.WriteAllBytes(path, data);
+                CrcResults results = Crc.crcFile(path, CrcAlgorithms.CRC32 | CrcAlgorithms.CRC32C | CrcAlgorithms.CRC64NVME);
+                Assert.Equal(Crc.crc32(data), results.Crc32);
+                Assert.Equal(Crc.crc32c(data), results.Crc32c);
+                Assert.Equal(Crc.crc64nvme(data), results.Crc64nvme);
+                Assert.Equal(Crc.crc32c(data, 4097, 1000), Crc.crc32cFile(path, 4097, 1000));
+                Assert.Equal(Crc.crc64nvme(data, 12345, data.Length - 12345), Crc.crc64nvmeFile(path, 12345));
+                Assert.Equal(0u, Crc.crc32File(path, data.Length));
+                Assert.Throws<NativeException>(() => Crc.crc32File(path, 0, data.Length + 1));
+            } finally {
+                File.Delete(path);
+            }
+            Assert.Throws<NativeException>(() => Crc.crc32cFile(path));
+        }
+        [Fact]
+        public void TestCrcBatch()
+        {
+            byte[] data = new byte[10000];
+            new Random(11).NextBytes(data);
+            int[] offsets = {0, 100, 4096, 9999, 5000};
+            int[] lengths = {100, 3000, 4000, 1, 0};
+            uint[] crc32s = new uint[offsets.Length];
+            uint[] crc32cs = new uint[offsets.Length];
+            ulong[] crc64s = new ulong[offsets.Length];
+            Crc.crc32Batch(data, offsets, lengths, crc32s);
+            Crc.crc32cBatch(data, offsets, lengths, crc32cs);
+            Crc.crc64nvmeBatch(data, offsets, lengths, crc64s);
+            for (int i = 0; i < offsets.Length; ++i) {
+                Assert.Equal(Crc.crc32(data, offsets[i], lengths[i]), crc32s[i]);
+                Assert.Equal(Crc.crc32c(data, offsets[i], lengths[i]), crc32cs[i]);
+                Assert.Equal(Crc.crc64nvme(data, offsets[i], lengths[i]), crc64s[i]);
+            }
+            Assert.Throws<ArgumentOutOfRangeException>(() => Crc.crc32cBatch(data, new int[] {9999}, new int[] {2}, crc32cs));
+            Assert.Throws<ArgumentException>(() => Crc.crc32cBatch(data, offsets, lengths, new uint[1]));
+        }
     }
 }
@@ -0,0 +1,85 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.IO;
+using System.Text;
+using Xunit;
+
+using Aws.Crt.Cal;
+using Aws.Crt.Checksums;
+
+namespace tests
+{
+    public class DigestSetTest : BaseTest
+    {
+        private static DigestAlgorithms All = DigestAlgorithms.MD5 | DigestAlgorithms.SHA1 | DigestAlgorithms.SHA256
+            | DigestAlgorithms.CRC32 | DigestAlgorithms.CRC32C | DigestAlgorithms.CRC64NVME;
+
+        [Fact]
+        public void TestDigestSetOneShot()
+        {
+            DigestSet set = new DigestSet(All);
+            set.update(Encoding.ASCII.GetBytes("abc"));
+            DigestSetResults res = set.digest();
+
+            byte[] md5 = {0x90,0x01,0x50,0x98,0x3c,0xd2,0x4f,0xb0,0xd6,0x96,0x3f,0x7d,0x28,0xe1,0x7f,0x72};
+            byte[] sha1 = {0xa9,0x99,0x3e,0x36,0x47,0x06,0x81,0x6a,0xba,0x3e,0x25,0x71,0x78,0x50,0xc2,0x6c,0x9c,0xd0,0xd8,0x9d};
+            byte[] sha256 = {0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad};
+            Assert.Equal(md5, res.Md5);
+            Assert.Equal(sha1, res.Sha1);
+            Assert.Equal(sha256, res.Sha256);
+            Assert.Equal(0x352441c2u, res.Crc32);
+            Assert.Equal(Crc.crc32c(Encoding.ASCII.GetBytes("abc")), res.Crc32c);
+            Assert.Equal(Crc.crc64nvme(Encoding.ASCII.GetBytes("abc")), res.Crc64nvme);
+        }
+
+        [Fact]
+        public void TestDigestSetMatchesSeparateDigests()
+        {
+            byte[] data = new byte[100000];
+            new Random(3).NextBytes(data);
+
+            DigestSet set = new DigestSet(DigestAlgorithms.MD5 | DigestAlgorithms.SHA256 | DigestAlgorithms.CRC32C);
+            set.update(data, 0, 1);
+            set.update(data, 1, 40000);
+            set.update(data, 40001, data.Length - 40001);
+            DigestSetResults res = set.digest();
+
+            Hash md5 = Hash.md5();
+            md5.update(data);
+            Hash sha256 = Hash.sha256();
+            sha256.update(data);
+            Assert.Equal(md5.digest(), res.Md5);
+            Assert.Equal(sha256.digest(), res.Sha256);
+            Assert.Equal(Crc.crc32c(data), res.Crc32c);
+            Assert.Null(res.Sha1);
+            Assert.Equal(0u, res.Crc32);
+        }
+
+        [Fact]
+        public void TestDigestSetFile()
+        {
+            byte[] data = new byte[70000];
+            new Random(5).NextBytes(data);
+            string path = Path.GetTempFileName();
+            try {
+                File.WriteAllBytes(path, data);
+                DigestSet set = new DigestSet(All);
+                set.updateFile(path, 10);
+                DigestSetResults res = set.digest();
+
+                Hash sha1 = Hash.sha1();
+                byte[] tail = new byte[data.Length - 10];
+                Array.Copy(data, 10, tail, 0, tail.Length);
+                sha1.update(tail);
+                Assert.Equal(sha1.digest(), res.Sha1);
+                Assert.Equal(Crc.crc32(tail), res.Crc32);
+                Assert.Equal(Crc.crc64nvme(tail), res.Crc64nvme);
+            } finally {
+                File.Delete(path);
+            }
+        }
+    }
+}
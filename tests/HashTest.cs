@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 using System;
+using System.IO;
 using System.Text;
 using Xunit;
 
@@ -102,5 +103,135 @@ namespace tests
             byte[] expected = {0x90,0x01,0x50,0x98,0x3c,0xd2,0x4f,0xb0,0xd6,0x96,0x3f,0x7d,0x28,0xe1,0x7f,0x72};
             Assert.Equal(expected, res);
         }
+
+        [Fact]
+        public void TestSha256File()
+        {
+            string path = Path.GetTempFileName();
+            try {
+                File.WriteAllBytes(path, Encoding.ASCII.GetBytes("xxabcxx"));
+                Hash sha256 = Hash.sha256();
+                sha256.updateFile(path, 2, 3);
+                byte[] expected = {0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad};
+                Assert.Equal(expected, sha256.digest());
+
+                Hash md5 = Hash.md5();
+                md5.updateFile(path, 7);
+                byte[] empty = {0xd4,0x1d,0x8c,0xd9,0x8f,0x00,0xb2,0x04,0xe9,0x80,0x09,0x98,0xec,0xf8,0x42,0x7e};
+                Assert.Equal(empty, md5.digest());
+            } finally {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestSha256FileWithNonAsciiName()
+        {
+            string path = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName() + "-é日");
+            try {
+                File.WriteAllBytes(path, Encoding.ASCII.GetBytes("abc"));
+                Hash sha256 = Hash.sha256();
+                sha256.updateFile(path);
+                byte[] expected = {0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad};
+                Assert.Equal(expected, sha256.digest());
+            } finally {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestSha256Reset()
+        {
+            byte[] expected = {0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad};
+            Hash sha256 = Hash.sha256();
+            sha256.update(Encoding.ASCII.GetBytes("xyz"));
+            sha256.reset();
+            sha256.update(Encoding.ASCII.GetBytes("abc"));
+            Assert.Equal(expected, sha256.digest());
+
+            sha256.reset();
+            sha256.update(Encoding.ASCII.GetBytes("abc"));
+            Assert.Equal(expected, sha256.digest());
+        }
+
+        [Fact]
+        public void TestMd5Slice()
+        {
+            Hash md5 = Hash.md5();
+            md5.update(Encoding.ASCII.GetBytes("xxabcxx"), 2, 3);
+            byte[] expected = {0x90,0x01,0x50,0x98,0x3c,0xd2,0x4f,0xb0,0xd6,0x96,0x3f,0x7d,0x28,0xe1,0x7f,0x72};
+            Assert.Equal(expected, md5.digest());
+            Assert.Throws<ArgumentOutOfRangeException>(() => Hash.md5().update(new byte[4], 2, 3));
+        }
+
+        [Fact]
+        public void TestSha1DigestIntoBuffer()
+        {
+            Hash sha1 = Hash.sha1();
+            sha1.update(Encoding.ASCII.GetBytes("abc"));
+            byte[] output = new byte[24];
+            Assert.Equal(20, sha1.digest(output, 4));
+            byte[] expected = {0,0,0,0,0xa9,0x99,0x3e,0x36,0x47,0x06,0x81,0x6a,0xba,0x3e,0x25,0x71,0x78,0x50,0xc2,0x6c,0x9c,0xd0,0xd8,0x9d};
+            Assert.Equal(expected, output);
+
+            sha1.reset();
+            sha1.update(Encoding.ASCII.GetBytes("abc"));
+            byte[] truncated = new byte[4];
+            Assert.Equal(4, sha1.digest(truncated, 0, 4));
+            Assert.Equal(new byte[] {0xa9,0x99,0x3e,0x36}, truncated);
+            Assert.Throws<ArgumentOutOfRangeException>(() => Hash.sha1().digest(new byte[19], 0));
+        }
+
+        [Fact]
+        public void TestHashPool()
+        {
+            byte[] expected = {0x90,0x01,0x50,0x98,0x3c,0xd2,0x4f,0xb0,0xd6,0x96,0x3f,0x7d,0x28,0xe1,0x7f,0x72};
+            HashPool pool = new HashPool(DigestAlgorithms.MD5, 1);
+            Hash first = pool.acquire();
+            first.update(Encoding.ASCII.GetBytes("partial"));
+            pool.release(first);
+            Assert.Throws<ArgumentException>(() => pool.release(first));
+            pool.release(Hash.md5());
+            Assert.Equal(1, pool.Count);
+
+            Hash reused = pool.acquire();
+            Assert.Same(first, reused);
+            reused.update(Encoding.ASCII.GetBytes("abc"));
+            Assert.Equal(expected, reused.digest());
+            Assert.Equal(0, pool.Count);
+
+            Assert.Throws<ArgumentException>(() => pool.release(Hash.sha1()));
+            Assert.Throws<ArgumentException>(() => new HashPool(DigestAlgorithms.SHA256).release(Hash.md5()));
+            Assert.Throws<ArgumentOutOfRangeException>(() => new HashPool(DigestAlgorithms.CRC32));
+            Assert.Equal(0, pool.Count);
+        }
+
+        [Fact]
+        public void TestHashBatch()
+        {
+            byte[] data = new byte[8192];
+            new Random(13).NextBytes(data);
+            int[] offsets = {0, 64, 1000, 8192};
+            int[] lengths = {64, 55, 4000, 0};
+            byte[] digests = new byte[offsets.Length * 32];
+            Hash.sha256Batch(data, offsets, lengths, digests);
+            for (int i = 0; i < offsets.Length; ++i) {
+                Hash sha256 = Hash.sha256();
+                sha256.update(data, offsets[i], lengths[i]);
+                byte[] expected = sha256.digest();
+                byte[] actual = new byte[32];
+                Array.Copy(digests, i * 32, actual, 0, 32);
+                Assert.Equal(expected, actual);
+            }
+
+            byte[] md5s = new byte[offsets.Length * 16];
+            Hash.md5Batch(data, offsets, lengths, md5s);
+            Hash md5 = Hash.md5();
+            md5.update(data, 1000, 4000);
+            byte[] md5Actual = new byte[16];
+            Array.Copy(md5s, 2 * 16, md5Actual, 0, 16);
+            Assert.Equal(md5.digest(), md5Actual);
+            Assert.Throws<ArgumentException>(() => Hash.sha1Batch(data, offsets, lengths, new byte[20]));
+        }
     }
 }
@@ -0,0 +1,328 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Net;
+using System.Net.Sockets;
+using System.Threading;
+using Xunit;
+
+using Aws.Crt.Http;
+using Aws.Crt.IO;
+
+namespace tests
+{
+    /*
+     * A plaintext HTTP/2 server on loopback, for clients with prior knowledge, that answers every request with a 200
+     * and the same body.  It ignores the request's headers and body, and sends the response body only as fast as the
+     * client's flow-control windows allow.
+     */
+    class LocalHttp2Server : IDisposable
+    {
+        private const byte DataFrame = 0x0;
+        private const byte HeadersFrame = 0x1;
+        private const byte SettingsFrame = 0x4;
+        private const byte PingFrame = 0x6;
+        private const byte GoAwayFrame = 0x7;
+        private const byte WindowUpdateFrame = 0x8;
+
+        private const byte EndStreamFlag = 0x1;
+        private const byte AckFlag = 0x1;
+        private const byte EndHeadersFlag = 0x4;
+
+        private const int InitialWindowSizeSetting = 0x4;
+        private const int DefaultWindowSize = 65535;
+        private const int MaxFrameSize = 16384;
+        private const int PrefaceLength = 24;
+
+        // HPACK static table entry 8, ":status: 200"
+        private static readonly byte[] Status200 = { 0x88 };
+
+        private class Response
+        {
+            public long Window;
+            public int Sent;
+        }
+
+        private TcpListener listener;
+        private byte[] body;
+
+        public UInt16 Port { get; private set; }
+
+        public LocalHttp2Server(byte[] body)
+        {
+            this.body = body;
+            listener = new TcpListener(IPAddress.Loopback, 0);
+            listener.Start();
+            Port = (UInt16)((IPEndPoint)listener.LocalEndpoint).Port;
+
+            var acceptThread = new Thread(Accept);
+            acceptThread.IsBackground = true;
+            acceptThread.Start();
+        }
+
+        private void Accept()
+        {
+            try
+            {
+                while (true)
+                {
+                    var client = listener.AcceptTcpClient();
+                    var connectionThread = new Thread(() => Serve(client));
+                    connectionThread.IsBackground = true;
+                    connectionThread.Start();
+                }
+            }
+            catch (SocketException)
+            {
+                // Stopped
+            }
+        }
+
+        // Reads exactly length bytes, or returns null at the end of the stream
+        private static byte[] ReadExactly(Stream stream, int length)
+        {
+            var buffer = new byte[length];
+            for (int offset = 0, read; offset < length; offset += read)
+            {
+                if ((read = stream.Read(buffer, offset, length - offset)) == 0)
+                {
+                    return null;
+                }
+            }
+            return buffer;
+        }
+
+        private static long ReadUInt31(byte[] buffer, int offset)
+        {
+            return ((long)(buffer[offset] & 0x7F) << 24) | ((long)buffer[offset + 1] << 16) | ((long)buffer[offset + 2] << 8) | buffer[offset + 3];
+        }
+
+        private static void WriteFrame(Stream stream, byte type, byte flags, int streamId, byte[] payload, int offset, int length)
+        {
+            var header = new byte[] {
+                (byte)(length >> 16), (byte)(length >> 8), (byte)length,
+                type, flags,
+                (byte)(streamId >> 24), (byte)(streamId >> 16), (byte)(streamId >> 8), (byte)streamId,
+            };
+            stream.Write(header, 0, header.Length);
+            stream.Write(payload, offset, length);
+        }
+
+        private void Serve(TcpClient client)
+        {
+            using (client)
+            using (var stream = client.GetStream())
+            {
+                try
+                {
+                    if (ReadExactly(stream, PrefaceLength) == null)
+                    {
+                        return;
+                    }
+                    WriteFrame(stream, SettingsFrame, 0, 0, new byte[0], 0, 0);
+
+                    long connectionWindow = DefaultWindowSize;
+                    long initialStreamWindow = DefaultWindowSize;
+                    var responses = new Dictionary<int, Response>();
+                    while (true)
+                    {
+                        var header = ReadExactly(stream, 9);
+                        if (header == null)
+                        {
+                            return;
+                        }
+
+                        int length = (header[0] << 16) | (header[1] << 8) | header[2];
+                        byte type = header[3];
+                        byte flags = header[4];
+                        int streamId = (int)ReadUInt31(header, 5);
+                        var payload = ReadExactly(stream, length);
+                        if (payload == null)
+                        {
+                            return;
+                        }
+
+                        switch (type)
+                        {
+                            case SettingsFrame:
+                                if ((flags & AckFlag) == 0)
+                                {
+                                    for (int i = 0; i + 6 <= length; i += 6)
+                                    {
+                                        if (((payload[i] << 8) | payload[i + 1]) == InitialWindowSizeSetting)
+                                        {
+                                            long windowSize = ReadUInt31(payload, i + 2);
+                                            foreach (var response in responses.Values)
+                                            {
+                                                response.Window += windowSize - initialStreamWindow;
+                                            }
+                                            initialStreamWindow = windowSize;
+                                        }
+                                    }
+                                    WriteFrame(stream, SettingsFrame, AckFlag, 0, new byte[0], 0, 0);
+                                }
+                                break;
+
+                            case PingFrame:
+                                if ((flags & AckFlag) == 0)
+                                {
+                                    WriteFrame(stream, PingFrame, AckFlag, 0, payload, 0, length);
+                                }
+                                break;
+
+                            case WindowUpdateFrame:
+                                Response updated;
+                                if (streamId == 0)
+                                {
+                                    connectionWindow += ReadUInt31(payload, 0);
+                                }
+                                else if (responses.TryGetValue(streamId, out updated))
+                                {
+                                    updated.Window += ReadUInt31(payload, 0);
+                                }
+                                break;
+
+                            case HeadersFrame:
+                            case DataFrame:
+                                // Respond once the whole request has arrived
+                                if ((flags & EndStreamFlag) != 0)
+                                {
+                                    WriteFrame(stream, HeadersFrame, EndHeadersFlag, streamId, Status200, 0, Status200.Length);
+                                    responses[streamId] = new Response { Window = initialStreamWindow };
+                                }
+                                break;
+
+                            case GoAwayFrame:
+                                return;
+                        }
+
+                        // Send as much of each response body as the windows now allow
+                        foreach (var entry in responses.ToList())
+                        {
+                            var response = entry.Value;
+                            while (response.Window > 0 && connectionWindow > 0)
+                            {
+                                int size = (int)Math.Min(Math.Min(body.Length - response.Sent, MaxFrameSize), Math.Min(response.Window, connectionWindow));
+                                bool last = response.Sent + size == body.Length;
+                                WriteFrame(stream, DataFrame, last ? EndStreamFlag : (byte)0, entry.Key, body, response.Sent, size);
+                                response.Sent += size;
+                                response.Window -= size;
+                                connectionWindow -= size;
+                                if (last)
+                                {
+                                    responses.Remove(entry.Key);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+                catch (IOException)
+                {
+                    // Client went away
+                }
+            }
+        }
+
+        public void Dispose()
+        {
+            listener.Stop();
+        }
+    }
+
+    public class Http2StreamManagerTest : BaseTest
+    {
+        // Larger than both the default stream window and a frame
+        private static readonly byte[] LargeBody = Enumerable.Range(0, 100 * 1024).Select(i => (byte)(i * 7)).ToArray();
+
+        private static Http2StreamManager NewManager(LocalHttp2Server server, Action<Http2StreamManagerOptions> configure = null)
+        {
+            var elg = new EventLoopGroup(1);
+            var options = new Http2StreamManagerOptions();
+            options.Bootstrap = new ClientBootstrap(elg, new DefaultHostResolver(elg));
+            options.Host = "127.0.0.1";
+            options.Port = server.Port;
+            options.Http2PriorKnowledge = true;
+            options.MaxConnections = 1;
+            if (configure != null)
+            {
+                configure(options);
+            }
+
+            return new Http2StreamManager(options);
+        }
+
+        private static HttpRequest NewRequest(UInt16 port)
+        {
+            var request = new HttpRequest();
+            request.Method = "GET";
+            request.Uri = "/";
+            request.Headers = new HttpHeader[] { new HttpHeader("Host", String.Format("127.0.0.1:{0}", port)) };
+            return request;
+        }
+
+        [Fact]
+        public void NeedsTlsOrPriorKnowledge()
+        {
+            using (var server = new LocalHttp2Server(LargeBody))
+            {
+                Assert.Throws<ArgumentException>(() => NewManager(server, options => options.Http2PriorKnowledge = false));
+            }
+        }
+
+        [Fact]
+        public void PriorKnowledgeRoundTrip()
+        {
+            using (var server = new LocalHttp2Server(LargeBody))
+            {
+                var manager = NewManager(server);
+
+                var body = new MemoryStream();
+                int status = 0;
+                var responseHandler = new HttpResponseStreamHandler();
+                responseHandler.IncomingHeaders += (sender, e) => { };
+                responseHandler.IncomingBody += (sender, e) => body.Write(e.Data, 0, e.Length);
+                responseHandler.StreamComplete += (sender, e) => status = ((HttpClientStream)sender).ResponseStatusCode;
+
+                // Two streams in turn on the one connection
+                for (int i = 0; i < 2; ++i)
+                {
+                    body.SetLength(0);
+                    Assert.Equal(0, manager.MakeRequest(NewRequest(server.Port), responseHandler).Get().ErrorCode);
+                    Assert.Equal(200, status);
+                    Assert.Equal(LargeBody, body.ToArray());
+                }
+            }
+        }
+
+        [Fact]
+        public void BodyReaderOpensTheStreamWindowAsItReads()
+        {
+            using (var server = new LocalHttp2Server(LargeBody))
+            {
+                var manager = NewManager(server, options =>
+                {
+                    // Smaller than the body, so it only completes if reading opens the window
+                    options.InitialWindowSize = 1024;
+                    options.ManualWindowManagement = true;
+                });
+
+                var responseHandler = new HttpResponseStreamHandler();
+                responseHandler.IncomingHeaders += (sender, e) => { };
+                using (var reader = new HttpResponseBodyReader(responseHandler))
+                {
+                    var result = manager.MakeRequest(NewRequest(server.Port), responseHandler);
+                    var body = new MemoryStream();
+                    reader.CopyTo(body);
+                    Assert.Equal(LargeBody, body.ToArray());
+                    result.Get();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,512 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.IO;
+using System.Linq;
+using System.Net;
+using System.Net.Sockets;
+using System.Runtime.CompilerServices;
+using System.Text;
+using System.Threading;
+using Xunit;
+
+using Aws.Crt.Http;
+using Aws.Crt.IO;
+
+namespace tests
+{
+    // A plain-HTTP server on loopback that answers every request on a connection with a keep-alive response
+    class LocalHttpServer : IDisposable
+    {
+        private TcpListener listener;
+        private int acceptedConnections;
+
+        // Builds the response to a request from its body
+        private Func<byte[], byte[]> respond;
+
+        public UInt16 Port { get; private set; }
+        public int AcceptedConnections { get { return Volatile.Read(ref acceptedConnections); } }
+
+        public LocalHttpServer() : this(body => Response("", Encoding.ASCII.GetBytes("hello")))
+        {
+        }
+
+        public LocalHttpServer(Func<byte[], byte[]> respond)
+        {
+            this.respond = respond;
+            listener = new TcpListener(IPAddress.Loopback, 0);
+            listener.Start();
+            Port = (UInt16)((IPEndPoint)listener.LocalEndpoint).Port;
+
+            var acceptThread = new Thread(Accept);
+            acceptThread.IsBackground = true;
+            acceptThread.Start();
+        }
+
+        // A 200 response with body, after headers, each of which ends in CRLF
+        public static byte[] Response(string headers, byte[] body)
+        {
+            var head = Encoding.UTF8.GetBytes(String.Format("HTTP/1.1 200 OK\r\n{0}Content-Length: {1}\r\n\r\n", headers, body.Length));
+            return head.Concat(body).ToArray();
+        }
+
+        private void Accept()
+        {
+            try
+            {
+                while (true)
+                {
+                    var client = listener.AcceptTcpClient();
+                    Interlocked.Increment(ref acceptedConnections);
+                    var connectionThread = new Thread(() => Serve(client));
+                    connectionThread.IsBackground = true;
+                    connectionThread.Start();
+                }
+            }
+            catch (SocketException)
+            {
+                // Stopped
+            }
+        }
+
+        // Reads a CRLF terminated line, without the CRLF, or returns null at the end of the stream
+        private static string ReadLine(Stream stream)
+        {
+            var line = new StringBuilder();
+            int c;
+            while ((c = stream.ReadByte()) >= 0)
+            {
+                if (c == '\n')
+                {
+                    return line.ToString().TrimEnd('\r');
+                }
+                line.Append((char)c);
+            }
+
+            return null;
+        }
+
+        // Reads length bytes, or returns null if the stream ends first
+        private static byte[] ReadBody(Stream stream, int length)
+        {
+            var body = new byte[length];
+            for (int offset = 0, read; offset < length; offset += read)
+            {
+                if ((read = stream.Read(body, offset, length - offset)) == 0)
+                {
+                    return null;
+                }
+            }
+
+            return body;
+        }
+
+        // Reads chunks up to the empty last one and the trailers after it, or returns null if the stream ends first
+        private static byte[] ReadChunkedBody(Stream stream)
+        {
+            var body = new MemoryStream();
+            while (true)
+            {
+                string size = ReadLine(stream);
+                if (size == null)
+                {
+                    return null;
+                }
+
+                int length = Convert.ToInt32(size.Split(';')[0].Trim(), 16);
+                if (length == 0)
+                {
+                    break;
+                }
+
+                var chunk = ReadBody(stream, length);
+                if (chunk == null || ReadLine(stream) == null)
+                {
+                    return null;
+                }
+                body.Write(chunk, 0, chunk.Length);
+            }
+
+            string trailer;
+            while (!String.IsNullOrEmpty(trailer = ReadLine(stream)))
+            {
+            }
+
+            return trailer == null ? null : body.ToArray();
+        }
+
+        private void Serve(TcpClient client)
+        {
+            using (client)
+            using (var stream = client.GetStream())
+            {
+                try
+                {
+                    string line;
+                    while ((line = ReadLine(stream)) != null)
+                    {
+                        // Skip the request line, then read headers up to the blank line for the body's framing
+                        int contentLength = 0;
+                        bool chunked = false;
+                        while (!String.IsNullOrEmpty(line = ReadLine(stream)))
+                        {
+                            if (line.StartsWith("Content-Length:", StringComparison.OrdinalIgnoreCase))
+                            {
+                                contentLength = int.Parse(line.Substring("Content-Length:".Length).Trim());
+                            }
+                            else if (line.StartsWith("Transfer-Encoding:", StringComparison.OrdinalIgnoreCase))
+                            {
+                                chunked = line.EndsWith("chunked", StringComparison.OrdinalIgnoreCase);
+                            }
+                        }
+
+                        var body = chunked ? ReadChunkedBody(stream) : ReadBody(stream, contentLength);
+                        if (body == null)
+                        {
+                            return;
+                        }
+
+                        var response = respond(body);
+                        stream.Write(response, 0, response.Length);
+                    }
+                }
+                catch (IOException)
+                {
+                    // Client went away
+                }
+            }
+        }
+
+        public void Dispose()
+        {
+            listener.Stop();
+        }
+    }
+
+    public class HttpClientConnectionManagerTest : BaseTest
+    {
+        private static ClientBootstrap NewBootstrap()
+        {
+            var elg = new EventLoopGroup(1);
+            return new ClientBootstrap(elg, new DefaultHostResolver(elg));
+        }
+
+        // A manager for server, allowing a single connection unless configure says otherwise
+        internal static HttpClientConnectionManager NewManager(LocalHttpServer server, Action<HttpClientConnectionManagerOptions> configure = null)
+        {
+            var options = new HttpClientConnectionManagerOptions();
+            options.Bootstrap = NewBootstrap();
+            options.Host = "127.0.0.1";
+            options.Port = server.Port;
+            options.MaxConnections = 1;
+            if (configure != null)
+            {
+                configure(options);
+            }
+
+            return new HttpClientConnectionManager(options);
+        }
+
+        private static string Get(HttpClientConnection connection, UInt16 port)
+        {
+            var request = new HttpRequest();
+            request.Method = "GET";
+            request.Uri = "/";
+            request.Headers = new HttpHeader[] { new HttpHeader("Host", String.Format("127.0.0.1:{0}", port)) };
+
+            var body = new MemoryStream();
+            var responseHandler = new HttpResponseStreamHandler();
+            responseHandler.IncomingHeaders += (sender, e) => { };
+            responseHandler.IncomingBody += (sender, e) => body.Write(e.Data, 0, e.Length);
+            responseHandler.StreamComplete += (sender, e) => { };
+
+            connection.MakeRequest(request, responseHandler).Get();
+            return Encoding.ASCII.GetString(body.ToArray());
+        }
+
+        [Fact]
+        public void AcquiredConnectionsAreReused()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server);
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    var connection = manager.AcquireConnection().Get();
+                    Assert.Equal("hello", Get(connection, server.Port));
+                    manager.ReleaseConnection(connection);
+                }
+
+                Assert.Equal(1, server.AcceptedConnections);
+            }
+        }
+
+        [Fact]
+        public void MetricsTrackAcquisitionsAndLeases()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server, options => options.MaxConnections = 2);
+
+                var first = manager.AcquireConnection().Get();
+                var second = manager.AcquireConnection().Get();
+
+                var metrics = manager.FetchMetrics();
+                Assert.Equal(2UL, metrics.LeasedConnections);
+                Assert.Equal(0UL, metrics.AvailableConnections);
+
+                manager.ReleaseConnection(first);
+                manager.ReleaseConnection(second);
+                manager.ReleaseConnection(manager.AcquireConnection().Get());
+
+                metrics = manager.FetchMetrics();
+                Assert.Equal(0UL, metrics.LeasedConnections);
+                Assert.Equal(2UL, metrics.AvailableConnections);
+                Assert.Equal(2, server.AcceptedConnections);
+                Assert.Equal(3, metrics.Acquisitions);
+                Assert.Equal(0, metrics.FailedAcquisitions);
+                Assert.Equal(3, metrics.AcquireWaitCounts.Sum());
+            }
+        }
+
+        [Fact]
+        public void WarmConnectionsAreOpenedEagerly()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server, options =>
+                {
+                    options.MaxConnections = 4;
+                    options.MinWarmConnections = 2;
+                    options.MaxConnectionIdleTimeMs = 60000;
+                });
+
+                for (int i = 0; i < 100 && manager.FetchMetrics().AvailableConnections < 2; ++i)
+                {
+                    Thread.Sleep(50);
+                }
+
+                var metrics = manager.FetchMetrics();
+                Assert.Equal(2UL, metrics.AvailableConnections);
+                Assert.Equal(0, metrics.Acquisitions);
+                Assert.Equal(2, server.AcceptedConnections);
+
+                // A burst within the warm set opens no new connections
+                var first = manager.AcquireConnection().Get();
+                var second = manager.AcquireConnection().Get();
+                manager.ReleaseConnection(first);
+                manager.ReleaseConnection(second);
+                Assert.Equal(2, server.AcceptedConnections);
+            }
+        }
+
+        [Fact]
+        public void WarmConnectionsAreKeptIdleBeyondLeases()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server, options =>
+                {
+                    options.MaxConnections = 3;
+                    options.MinWarmConnections = 2;
+                    // Tops up twice a second
+                    options.MaxConnectionIdleTimeMs = 1000;
+                });
+
+                for (int i = 0; i < 100 && manager.FetchMetrics().AvailableConnections < 2; ++i)
+                {
+                    Thread.Sleep(50);
+                }
+
+                // Leasing both warm connections leaves room under MaxConnections to reopen only one
+                var first = manager.AcquireConnection().Get();
+                var second = manager.AcquireConnection().Get();
+                for (int i = 0; i < 100 && manager.FetchMetrics().AvailableConnections < 1; ++i)
+                {
+                    Thread.Sleep(50);
+                }
+
+                var metrics = manager.FetchMetrics();
+                Assert.Equal(2UL, metrics.LeasedConnections);
+                Assert.Equal(1UL, metrics.AvailableConnections);
+                Assert.Equal(3, server.AcceptedConnections);
+
+                manager.ReleaseConnection(first);
+                manager.ReleaseConnection(second);
+            }
+        }
+
+        [Fact]
+        public void PoolEvictsIdleEndpointsToStayUnderCap()
+        {
+            using (var first = new LocalHttpServer())
+            using (var second = new LocalHttpServer())
+            {
+                var options = new HttpClientConnectionPoolOptions();
+                options.Bootstrap = NewBootstrap();
+                options.MaxConnections = 1;
+                options.MaxConnectionsPerEndpoint = 1;
+                options.MaxIdleEndpoints = 4;
+                var pool = new HttpClientConnectionPool(options);
+
+                var firstConnection = pool.AcquireConnection("127.0.0.1", first.Port).Get();
+                Assert.Equal("hello", Get(firstConnection, first.Port));
+
+                // The cap is reached, so the second endpoint waits for the first to be released and evicted
+                var acquired = new ManualResetEvent(false);
+                var secondResult = pool.AcquireConnection("127.0.0.1", second.Port);
+                secondResult.CompletionCallback = (connection) => acquired.Set();
+                Assert.False(acquired.WaitOne(200));
+
+                pool.ReleaseConnection(firstConnection);
+                var secondConnection = secondResult.Get();
+                Assert.Equal("hello", Get(secondConnection, second.Port));
+                Assert.Equal(1, pool.EndpointCount);
+
+                pool.ReleaseConnection(secondConnection);
+            }
+        }
+
+        [Fact]
+        public void PoolCountsIdleConnectionsThatCloseOnTheirOwn()
+        {
+            using (var first = new LocalHttpServer())
+            using (var second = new LocalHttpServer())
+            {
+                var options = new HttpClientConnectionPoolOptions();
+                options.Bootstrap = NewBootstrap();
+                options.MaxConnections = 2;
+                options.MaxConnectionsPerEndpoint = 2;
+                options.MaxConnectionIdleTimeMs = 100;
+                var pool = new HttpClientConnectionPool(options);
+
+                // The first endpoint keeps a lease, so it can't be evicted, and its idle connection is culled
+                var leased = pool.AcquireConnection("127.0.0.1", first.Port).Get();
+                pool.ReleaseConnection(pool.AcquireConnection("127.0.0.1", first.Port).Get());
+                Thread.Sleep(500);
+
+                var acquired = new ManualResetEvent(false);
+                var secondResult = pool.AcquireConnection("127.0.0.1", second.Port);
+                secondResult.CompletionCallback = (connection) => acquired.Set();
+                Assert.True(acquired.WaitOne(5000));
+                Assert.Equal(2, pool.EndpointCount);
+
+                pool.ReleaseConnection(secondResult.Get());
+                pool.ReleaseConnection(leased);
+            }
+        }
+
+        // Leases a connection from pool and drops it without releasing it
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static void LeakConnection(HttpClientConnectionPool pool, UInt16 port)
+        {
+            pool.AcquireConnection("127.0.0.1", port).Get();
+        }
+
+        [Fact]
+        public void PoolReclaimsLeakedConnections()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var options = new HttpClientConnectionPoolOptions();
+                options.Bootstrap = NewBootstrap();
+                options.MaxConnections = 1;
+                options.MaxConnectionsPerEndpoint = 1;
+                var pool = new HttpClientConnectionPool(options);
+
+                var released = pool.AcquireConnection("127.0.0.1", server.Port).Get();
+                pool.ReleaseConnection(released);
+                Assert.Throws<ArgumentException>(() => pool.ReleaseConnection(released));
+
+                // Once collected and finalized, the leaked connection no longer holds the only slot
+                LeakConnection(pool, server.Port);
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+
+                var acquired = new ManualResetEvent(false);
+                var result = pool.AcquireConnection("127.0.0.1", server.Port);
+                result.CompletionCallback = (connection) => acquired.Set();
+                Assert.True(acquired.WaitOne(5000));
+
+                pool.ReleaseConnection(result.Get());
+            }
+        }
+
+        [Fact]
+        public void PoolValidatesMaxIdleEndpoints()
+        {
+            var options = new HttpClientConnectionPoolOptions();
+            Assert.Equal(HttpClientConnectionPoolOptions.DefaultMaxIdleEndpoints, options.MaxIdleEndpoints);
+
+            options.Bootstrap = NewBootstrap();
+            options.MaxConnections = 1;
+            options.MaxConnectionsPerEndpoint = 1;
+            options.MaxIdleEndpoints = -1;
+            Assert.Throws<ArgumentOutOfRangeException>(() => new HttpClientConnectionPool(options));
+        }
+
+        [Fact]
+        public void PlaintextConnectionsSpeakHttp11()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server);
+
+                var connection = manager.AcquireConnection().Get();
+                Assert.Equal(HttpProtocolVersion.Http1_1, connection.Version);
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void BodyReaderOpensTheWindowAsItReads()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server, options =>
+                {
+                    // Smaller than the body, so it only completes if reading opens the window
+                    options.InitialWindowSize = 2;
+                    options.ManualWindowManagement = true;
+                });
+
+                var request = new HttpRequest();
+                request.Method = "GET";
+                request.Uri = "/";
+                request.Headers = new HttpHeader[] { new HttpHeader("Host", String.Format("127.0.0.1:{0}", server.Port)) };
+
+                var responseHandler = new HttpResponseStreamHandler();
+                responseHandler.IncomingHeaders += (sender, e) => { };
+                var connection = manager.AcquireConnection().Get();
+                using (var reader = new HttpResponseBodyReader(responseHandler))
+                {
+                    Assert.True(responseHandler.ReuseBodyEventArgs);
+                    var result = connection.MakeRequest(request, responseHandler);
+                    using (var body = new StreamReader(reader, Encoding.ASCII))
+                    {
+                        Assert.Equal("hello", body.ReadToEnd());
+                    }
+                    result.Get();
+                }
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void ReleasedConnectionCannotBeUsed()
+        {
+            using (var server = new LocalHttpServer())
+            {
+                var manager = NewManager(server);
+
+                var connection = manager.AcquireConnection().Get();
+                manager.ReleaseConnection(connection);
+
+                Assert.Throws<InvalidOperationException>(() => Get(connection, server.Port));
+            }
+        }
+    }
+}
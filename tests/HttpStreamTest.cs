@@ -0,0 +1,291 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Net;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using Xunit;
+
+using Aws.Crt;
+using Aws.Crt.Http;
+
+namespace tests
+{
+    // A Stream that only reads asynchronously, a few bytes at a time after a delay, or fails its first read
+    class SlowStream : Stream
+    {
+        private byte[] data;
+        private int position;
+        private bool fail;
+
+        public SlowStream(byte[] data, bool fail)
+        {
+            this.data = data;
+            this.fail = fail;
+        }
+
+        public override async Task<int> ReadAsync(byte[] buffer, int offset, int count, CancellationToken cancellationToken)
+        {
+            await Task.Delay(5);
+            if (fail)
+            {
+                throw new IOException("read failed");
+            }
+
+            int read = Math.Min(Math.Min(count, 3), data.Length - position);
+            Array.Copy(data, position, buffer, offset, read);
+            position += read;
+            return read;
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            throw new NotSupportedException("SlowStream is only read asynchronously");
+        }
+
+        public override bool CanRead { get { return true; } }
+        public override bool CanSeek { get { return false; } }
+        public override bool CanWrite { get { return false; } }
+        public override long Length { get { throw new NotSupportedException(); } }
+        public override long Position { get { throw new NotSupportedException(); } set { throw new NotSupportedException(); } }
+        public override void Flush() { }
+        public override long Seek(long offset, SeekOrigin origin) { throw new NotSupportedException(); }
+        public override void SetLength(long value) { throw new NotSupportedException(); }
+        public override void Write(byte[] buffer, int offset, int count) { throw new NotSupportedException(); }
+    }
+
+    // Hands out buffers a little larger than asked for, as pools do
+    class CountingBufferPool : IHttpBodyBufferPool
+    {
+        public int Rentals { get; private set; }
+
+        public byte[] Rent(int minimumLength)
+        {
+            ++Rentals;
+            return new byte[minimumLength + 16];
+        }
+    }
+
+    public class HttpStreamTest : BaseTest
+    {
+        // Large enough to arrive in several chunks
+        private static readonly byte[] LargeBody = Enumerable.Range(0, 256 * 1024).Select(i => (byte)(i * 7)).ToArray();
+
+        private static HttpRequest NewRequest(UInt16 port, params HttpHeader[] headers)
+        {
+            var request = new HttpRequest();
+            request.Method = "GET";
+            request.Uri = "/";
+            request.Headers = new HttpHeader[] { new HttpHeader("Host", String.Format("127.0.0.1:{0}", port)) }.Concat(headers).ToArray();
+            return request;
+        }
+
+        private static HttpRequest NewAsyncBodyRequest(UInt16 port, byte[] body, bool fail, params HttpHeader[] headers)
+        {
+            var request = NewRequest(port, headers);
+            request.Method = "PUT";
+            request.BodyStream = new SlowStream(body, fail);
+            request.AsyncBodyReads = true;
+            return request;
+        }
+
+        private static HttpResponseStreamHandler NewResponseHandler(MemoryStream body)
+        {
+            var responseHandler = new HttpResponseStreamHandler();
+            responseHandler.IncomingHeaders += (sender, e) => { };
+            responseHandler.IncomingBody += (sender, e) => body.Write(e.Data, 0, e.Length);
+            responseHandler.StreamComplete += (sender, e) => { };
+            return responseHandler;
+        }
+
+        [Fact]
+        public void AsyncBodyReadsSendSlowStreams()
+        {
+            var requestBody = Encoding.ASCII.GetBytes("a body read a few bytes at a time");
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response("", body)))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                var responseBody = new MemoryStream();
+                connection.MakeRequest(NewAsyncBodyRequest(server.Port, requestBody, false), NewResponseHandler(responseBody)).Get();
+                Assert.Equal(requestBody, responseBody.ToArray());
+
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void AsyncBodyReadFailureFailsTheRequest()
+        {
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response("", body)))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                var request = NewAsyncBodyRequest(server.Port, Encoding.ASCII.GetBytes("never sent"), true);
+                Assert.Throws<WebException>(() => connection.MakeRequest(request, NewResponseHandler(new MemoryStream())).Get());
+
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void AsyncBodiesAreChunkedOnHttp11()
+        {
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response("", body)))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                // Each read is sent as a chunk as soon as it finishes, so the length can't be sent up front
+                var request = NewAsyncBodyRequest(server.Port, Encoding.ASCII.GetBytes("sized"), false, new HttpHeader("Content-Length", "5"));
+                Assert.Throws<NativeException>(() => connection.MakeRequest(request, NewResponseHandler(new MemoryStream())));
+
+                var responseBody = new MemoryStream();
+                connection.MakeRequest(NewAsyncBodyRequest(server.Port, new byte[0], false), NewResponseHandler(responseBody)).Get();
+                Assert.Equal(0, responseBody.Length);
+
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void BodyChunksAreCopiedForHandlersThatKeepThem()
+        {
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response("", LargeBody)))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                var chunks = new List<IncomingBodyEventArgs>();
+                var responseHandler = NewResponseHandler(new MemoryStream());
+                responseHandler.IncomingBody += (sender, e) => chunks.Add(e);
+                connection.MakeRequest(NewRequest(server.Port), responseHandler).Get();
+
+                // Each chunk has its own event args, whose Data is still readable after the event
+                Assert.True(chunks.Count > 1);
+                Assert.Equal(chunks.Count, chunks.Distinct().Count());
+                Assert.Equal(LargeBody, chunks.SelectMany(e => e.Data).ToArray());
+
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void ReusedBodyEventArgsCopyToAndPooledData()
+        {
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response("", LargeBody)))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                var pool = new CountingBufferPool();
+                var copied = new MemoryStream();
+                var pooled = new MemoryStream();
+                var instances = new HashSet<IncomingBodyEventArgs>();
+                var responseHandler = new HttpResponseStreamHandler();
+                responseHandler.ReuseBodyEventArgs = true;
+                responseHandler.BodyBufferPool = pool;
+                responseHandler.IncomingHeaders += (sender, e) => { };
+                responseHandler.StreamComplete += (sender, e) => { };
+                responseHandler.IncomingBody += (sender, e) =>
+                {
+                    instances.Add(e);
+
+                    var buffer = new byte[e.Length + 1];
+                    e.CopyTo(buffer, 1);
+                    copied.Write(buffer, 1, e.Length);
+                    Assert.Throws<ArgumentOutOfRangeException>(() => e.CopyTo(buffer, 2));
+
+                    Assert.True(e.PooledData.Length >= e.Length);
+                    pooled.Write(e.PooledData, 0, e.Length);
+                };
+                connection.MakeRequest(NewRequest(server.Port), responseHandler).Get();
+
+                Assert.Single(instances);
+                Assert.True(pool.Rentals > 1);
+                Assert.Equal(LargeBody, copied.ToArray());
+                Assert.Equal(LargeBody, pooled.ToArray());
+
+                manager.ReleaseConnection(connection);
+            }
+        }
+
+        [Fact]
+        public void ResponseHeadersDecodeLazily()
+        {
+            var responseHeaders =
+                "Content-Type: text/plain\r\n" +
+                "x-amz-request-id: req-1\r\n" +
+                "CONTENT-ENCODING: identity\r\n" +
+                "Content-Tipe: typo\r\n" +
+                "X-Empty:\r\n" +
+                "X-Padded:   42\r\n" +
+                "X-Max: 9223372036854775807\r\n" +
+                "X-Overflow: 9223372036854775808\r\n" +
+                "X-Negative: -1\r\n" +
+                "X-Text: caf\u00e9\r\n";
+            using (var server = new LocalHttpServer(body => LocalHttpServer.Response(responseHeaders, Encoding.ASCII.GetBytes("hello"))))
+            {
+                var manager = HttpClientConnectionManagerTest.NewManager(server);
+                var connection = manager.AcquireConnection().Get();
+
+                HttpHeaderCollection headers = null;
+                var responseHandler = NewResponseHandler(new MemoryStream());
+                responseHandler.IncomingHeaders += (sender, e) =>
+                {
+                    if (e.Block == HeaderBlock.Main)
+                    {
+                        headers = e.HeaderCollection;
+                    }
+                };
+                connection.MakeRequest(NewRequest(server.Port), responseHandler).Get();
+                manager.ReleaseConnection(connection);
+
+                Assert.Equal(11, headers.Count);
+                Assert.Equal("X-Empty", headers[4].Name);
+                Assert.Equal("", headers[4].Value);
+                Assert.Equal("caf\u00e9", headers.GetValue(9));
+                Assert.Equal("Content-Length", headers.GetName(10));
+                Assert.Throws<ArgumentOutOfRangeException>(() => headers.GetName(11));
+
+                // Well-known names received in their usual or lower case decode to the interned strings
+                Assert.Same("Content-Type", headers.GetName(0));
+                Assert.Same("x-amz-request-id", headers.GetName(1));
+                Assert.Same(headers.GetName(0), headers.GetName(0));
+                Assert.Equal("CONTENT-ENCODING", headers.GetName(2));
+                Assert.Equal("Content-Tipe", headers.GetName(3));
+
+                // Lookups ignore case
+                Assert.Equal(2, headers.IndexOf("Content-Encoding"));
+                Assert.Equal(1, headers.IndexOf("X-AMZ-REQUEST-ID"));
+                Assert.Equal(-1, headers.IndexOf("Content-Typ"));
+                Assert.Equal(-1, headers.IndexOf("X-T\u00e9xt"));
+                string value;
+                Assert.True(headers.TryGetValue("content-tipe", out value));
+                Assert.Equal("typo", value);
+                Assert.False(headers.Contains("X-Missing"));
+
+                long number;
+                Assert.True(headers.TryGetInt64("content-length", out number));
+                Assert.Equal(5L, number);
+                Assert.True(headers.TryGetInt64("X-Padded", out number));
+                Assert.Equal(42L, number);
+                Assert.True(headers.TryGetInt64("X-Max", out number));
+                Assert.Equal(long.MaxValue, number);
+                Assert.False(headers.TryGetInt64("X-Overflow", out number));
+                Assert.False(headers.TryGetInt64("X-Negative", out number));
+                Assert.False(headers.TryGetInt64("X-Empty", out number));
+                Assert.False(headers.TryGetInt64("X-Text", out number));
+                Assert.False(headers.TryGetInt64("X-Missing", out number));
+            }
+        }
+    }
+}
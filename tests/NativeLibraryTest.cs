@@ -0,0 +1,196 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Security.Cryptography;
+using Xunit;
+
+using Aws.Crt;
+
+namespace tests
+{
+    public class NativeLibraryTest : BaseTest
+    {
+        private const string LibraryName = "libtest.so";
+        private const string LibraryPathEnvironmentVariable = "AWS_CRT_DOTNET_LIBRARY_PATH";
+
+        // The library is loaded once per process, so its extraction and lookup are called directly
+        private static readonly Type PlatformBinding = typeof(CRT).GetNestedType("PlatformBinding", BindingFlags.NonPublic);
+
+        // digest is the library's SHA-256 as embedded at build time, or null to have it computed
+        private static string ExtractCachedLibrary(byte[] library, string cacheDir, out bool extracted, string digest = null)
+        {
+            var arguments = new object[] { new MemoryStream(library), digest, LibraryName, cacheDir, null };
+            var path = (string)PlatformBinding.GetMethod("ExtractCachedLibrary", BindingFlags.NonPublic | BindingFlags.Static).Invoke(null, arguments);
+            extracted = (bool)arguments[4];
+            return path;
+        }
+
+        private static string Sha256Hex(byte[] data)
+        {
+            using (var sha256 = SHA256.Create())
+            {
+                return BitConverter.ToString(sha256.ComputeHash(data)).Replace("-", "").ToLowerInvariant();
+            }
+        }
+
+        private static string FindConfiguredLibrary(string configuredPath)
+        {
+            var previous = Environment.GetEnvironmentVariable(LibraryPathEnvironmentVariable);
+            Environment.SetEnvironmentVariable(LibraryPathEnvironmentVariable, configuredPath);
+            try
+            {
+                return (string)PlatformBinding.GetMethod("FindConfiguredLibrary", BindingFlags.NonPublic | BindingFlags.Static).Invoke(null, new object[] { LibraryName });
+            }
+            catch (TargetInvocationException ex)
+            {
+                throw ex.InnerException;
+            }
+            finally
+            {
+                Environment.SetEnvironmentVariable(LibraryPathEnvironmentVariable, previous);
+            }
+        }
+
+        private static string NewTempDirectory()
+        {
+            var path = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(path);
+            return path;
+        }
+
+        [Fact]
+        public void TestNativeLibraryLoaded()
+        {
+            Assert.True(File.Exists(CRT.NativeLibraryPath));
+            Assert.True(CRT.NativeLibraryLoadTime > TimeSpan.Zero);
+        }
+
+        [Fact]
+        public void TestNativeLibrarySourceMatchesEnvironment()
+        {
+            if (!String.IsNullOrEmpty(Environment.GetEnvironmentVariable("AWS_CRT_DOTNET_LIBRARY_PATH")))
+            {
+                Assert.Equal(NativeLibrarySource.Configured, CRT.NativeLibrarySource);
+            }
+            else if (CRT.NativeLibrarySource != NativeLibrarySource.ApplicationDirectory
+                && !String.IsNullOrEmpty(Environment.GetEnvironmentVariable("AWS_CRT_DOTNET_LIBRARY_CACHE_DIR")))
+            {
+                Assert.Equal(NativeLibrarySource.ExtractionCache, CRT.NativeLibrarySource);
+            }
+        }
+
+        [Fact]
+        public void CachedLibraryIsExtractedOnceAndReused()
+        {
+            var library = Enumerable.Range(0, 10000).Select(i => (byte)i).ToArray();
+            var cacheDir = NewTempDirectory();
+            try
+            {
+                bool extracted;
+                var path = ExtractCachedLibrary(library, cacheDir, out extracted);
+                Assert.True(extracted);
+                Assert.EndsWith("." + LibraryName, path);
+                Assert.Equal(library, File.ReadAllBytes(path));
+                var writeTime = File.GetLastWriteTimeUtc(path);
+
+                Assert.Equal(path, ExtractCachedLibrary(library, cacheDir, out extracted));
+                Assert.False(extracted);
+                Assert.Equal(writeTime, File.GetLastWriteTimeUtc(path));
+
+                // A different library is cached alongside it
+                library[0] ^= 0xFF;
+                Assert.NotEqual(path, ExtractCachedLibrary(library, cacheDir, out extracted));
+                Assert.True(extracted);
+                Assert.Equal(2, Directory.GetFiles(cacheDir).Length);
+            }
+            finally
+            {
+                Directory.Delete(cacheDir, true);
+            }
+        }
+
+        [Fact]
+        public void CorruptedOrTruncatedCachedLibraryIsReplaced()
+        {
+            var library = Enumerable.Range(0, 10000).Select(i => (byte)i).ToArray();
+            var cacheDir = NewTempDirectory();
+            try
+            {
+                bool extracted;
+                var path = ExtractCachedLibrary(library, cacheDir, out extracted);
+
+                // Same length, different contents
+                var corrupted = (byte[])library.Clone();
+                corrupted[5000] ^= 0xFF;
+                File.WriteAllBytes(path, corrupted);
+                Assert.Equal(path, ExtractCachedLibrary(library, cacheDir, out extracted));
+                Assert.True(extracted);
+                Assert.Equal(library, File.ReadAllBytes(path));
+
+                File.WriteAllBytes(path, library.Take(100).ToArray());
+                Assert.Equal(path, ExtractCachedLibrary(library, cacheDir, out extracted));
+                Assert.True(extracted);
+                Assert.Equal(library, File.ReadAllBytes(path));
+
+                // No temp files are left behind
+                Assert.Single(Directory.GetFiles(cacheDir));
+            }
+            finally
+            {
+                Directory.Delete(cacheDir, true);
+            }
+        }
+
+        [Fact]
+        public void IntactCachedLibraryIsReusedWithAPrecomputedDigest()
+        {
+            var library = Enumerable.Range(0, 10000).Select(i => (byte)i).ToArray();
+            var digest = Sha256Hex(library);
+            var cacheDir = NewTempDirectory();
+            try
+            {
+                bool extracted;
+                var path = ExtractCachedLibrary(library, cacheDir, out extracted, digest);
+                Assert.True(extracted);
+                Assert.Equal(library, File.ReadAllBytes(path));
+
+                // Another process's intact copy is used as it is, even while open for execution
+                using (new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read))
+                {
+                    Assert.Equal(path, ExtractCachedLibrary(library, cacheDir, out extracted, digest));
+                    Assert.False(extracted);
+                }
+                Assert.Single(Directory.GetFiles(cacheDir));
+            }
+            finally
+            {
+                Directory.Delete(cacheDir, true);
+            }
+        }
+
+        [Fact]
+        public void ConfiguredLibraryPathIsAFileOrDirectory()
+        {
+            var directory = NewTempDirectory();
+            try
+            {
+                var library = Path.Combine(directory, LibraryName);
+                File.WriteAllBytes(library, new byte[] { 0 });
+
+                Assert.Equal(library, FindConfiguredLibrary(directory));
+                Assert.Equal(library, FindConfiguredLibrary(library));
+                Assert.Null(FindConfiguredLibrary(null));
+                Assert.Throws<FileNotFoundException>(() => FindConfiguredLibrary(Path.Combine(directory, "missing.so")));
+            }
+            finally
+            {
+                Directory.Delete(directory, true);
+            }
+        }
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+
+using Aws.Crt;
+using Aws.Crt.Auth;
+using Aws.Crt.Cal;
+using Aws.Crt.Checksums;
+using Aws.Crt.Http;
+
+namespace Aws.Crt.Benchmarks
+{
+    class Benchmarks
+    {
+        internal static class API
+        {
+            [UnmanagedFunctionPointerAttribute(CallingConvention.Cdecl)]
+            public delegate UInt32 aws_dotnet_crc32([In, MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.U1)] byte[] buffer,
+                                                   UInt64 length, UInt32 previous);
+
+            public static aws_dotnet_crc32 crc32 = NativeAPI.Bind<aws_dotnet_crc32>();
+        }
+
+        delegate void Benchmark(string[] args);
+
+        static Dictionary<string, Benchmark> benchmarks = new Dictionary<string, Benchmark>()
+        {
+            { "native-call", NativeCallOverhead },
+            { "crc-parallel", CrcParallelScaling },
+            { "batch-small", BatchSmallRecords },
+            { "presign", PresignUrls },
+        };
+
+        static void ShowHelp()
+        {
+            Console.WriteLine("usage: benchmarks NAME [args]");
+            Console.WriteLine("Benchmarks:");
+            Console.WriteLine("  native-call [ITERATIONS]: per-call overhead of bound native functions.");
+            Console.WriteLine("  crc-parallel [SIZE_MB]: parallel CRC32C/CRC64NVME throughput by thread count.");
+            Console.WriteLine("  batch-small [RECORDS] [RECORD_SIZE]: per-record vs batched CRC32C and SHA256 of small records.");
+            Console.WriteLine("  presign [URLS]: per-request vs batched presigned URL generation.");
+        }
+
+        static int Main(string[] args)
+        {
+            Benchmark benchmark = null;
+            if (args.Length == 0 || !benchmarks.TryGetValue(args[0], out benchmark))
+            {
+                ShowHelp();
+                return 1;
+            }
+
+            string[] benchmarkArgs = new string[args.Length - 1];
+            Array.Copy(args, 1, benchmarkArgs, 0, benchmarkArgs.Length);
+            benchmark(benchmarkArgs);
+            return 0;
+        }
+
+        static int IntArg(string[] args, int index, int defaultValue)
+        {
+            return args.Length > index ? Int32.Parse(args[index]) : defaultValue;
+        }
+
+        static void Report(string name, long iterations, Stopwatch timer)
+        {
+            double nsPerOp = timer.Elapsed.TotalMilliseconds * 1000000.0 / iterations;
+            Console.WriteLine(String.Format("{0,-40} {1,12:N1} ns/op  ({2} ops in {3} ms)", name, nsPerOp, iterations, timer.ElapsedMilliseconds));
+        }
+
+        static void Measure(string name, int iterations, Action op)
+        {
+            // warm up the JIT and the native library before timing
+            for (int i = 0; i < Math.Min(iterations, 10000); ++i)
+            {
+                op();
+            }
+
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < iterations; ++i)
+            {
+                op();
+            }
+            timer.Stop();
+            Report(name, iterations, timer);
+        }
+
+        /*
+         * Compares a 1 byte CRC32 through the bound stub against the trampoline that NativeAPI.Bind used to
+         * generate, which boxed every argument into an object[] and called Delegate.DynamicInvoke.  The legacy
+         * path is reproduced here by wrapping the bound delegate, so it slightly overstates the old cost.
+         */
+        static void NativeCallOverhead(string[] args)
+        {
+            int iterations = IntArg(args, 0, 5000000);
+            byte[] buffer = new byte[1];
+            uint crc = 0;
+
+            Delegate bound = API.crc32;
+            API.aws_dotnet_crc32 legacy = (b, length, previous) => (UInt32)bound.DynamicInvoke(new object[] { b, length, previous });
+
+            Measure("crc32 (1 byte), DynamicInvoke trampoline", iterations, () => { crc = legacy(buffer, (ulong)buffer.Length, crc); });
+            Measure("crc32 (1 byte), direct stub", iterations, () => { crc = API.crc32(buffer, (ulong)buffer.Length, crc); });
+            Measure("Crc.crc32 (1 byte)", iterations, () => { crc = Crc.crc32(buffer, crc); });
+
+            Hash sha256 = Hash.sha256();
+            Measure("Hash.update (1 byte)", iterations, () => { sha256.update(buffer); });
+        }
+
+        static void CrcParallelScaling(string[] args)
+        {
+            int sizeMb = IntArg(args, 0, 1024);
+            byte[] buffer = new byte[(long)sizeMb * 1024 * 1024];
+            new Random(0).NextBytes(buffer);
+
+            for (int threads = 1; threads <= Environment.ProcessorCount; threads *= 2)
+            {
+                ReportThroughput($"crc32c, {threads} thread(s)", buffer.Length, () => Crc.crc32cParallel(buffer, threads));
+                ReportThroughput($"crc64nvme, {threads} thread(s)", buffer.Length, () => Crc.crc64nvmeParallel(buffer, threads));
+            }
+        }
+
+        static void BatchSmallRecords(string[] args)
+        {
+            int records = IntArg(args, 0, 100000);
+            int recordSize = IntArg(args, 1, 2048);
+            byte[] buffer = new byte[(long)records * recordSize];
+            new Random(0).NextBytes(buffer);
+            int[] offsets = new int[records];
+            int[] lengths = new int[records];
+            for (int i = 0; i < records; ++i)
+            {
+                offsets[i] = i * recordSize;
+                lengths[i] = recordSize;
+            }
+            uint[] crcs = new uint[records];
+            byte[] digests = new byte[records * 32];
+
+            ReportThroughput("crc32c, one call per record", buffer.Length, () => {
+                for (int i = 0; i < records; ++i)
+                {
+                    crcs[i] = Crc.crc32c(buffer, offsets[i], lengths[i]);
+                }
+            });
+            ReportThroughput("crc32c, batched", buffer.Length, () => Crc.crc32cBatch(buffer, offsets, lengths, crcs));
+            ReportThroughput("sha256, one Hash per record", buffer.Length, () => {
+                for (int i = 0; i < records; ++i)
+                {
+                    Hash sha256 = Hash.sha256();
+                    sha256.update(buffer, offsets[i], lengths[i]);
+                    sha256.digest(digests, i * 32);
+                }
+            });
+            ReportThroughput("sha256, batched", buffer.Length, () => Hash.sha256Batch(buffer, offsets, lengths, digests));
+        }
+
+        static void PresignUrls(string[] args)
+        {
+            int urls = IntArg(args, 0, 100000);
+            var config = new AwsSigningConfig();
+            config.SignatureType = AwsSignatureType.HTTP_REQUEST_VIA_QUERY_PARAMS;
+            config.Region = "us-east-1";
+            config.Service = "s3";
+            config.Credentials = new Credentials("AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY", null);
+            config.SignedBodyValue = AwsSignedBodyValue.UNSIGNED_PAYLOAD;
+            config.ExpirationInSeconds = 3600;
+
+            var requests = new HttpRequest[urls];
+            for (int i = 0; i < urls; ++i)
+            {
+                requests[i] = new HttpRequest();
+                requests[i].Method = "GET";
+                requests[i].Uri = "/examplebucket/object-" + i;
+                requests[i].Headers = new HttpHeader[] { new HttpHeader("Host", "examplebucket.s3.amazonaws.com") };
+            }
+
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < urls; ++i)
+            {
+                AwsSigner.SignHttpRequest(requests[i], config).Get();
+            }
+            timer.Stop();
+            Report("presign, one SignHttpRequest per url", urls, timer);
+
+            var preparedConfig = new AwsPreparedSigningConfig(config);
+            timer = Stopwatch.StartNew();
+            AwsSigner.PresignUrls(requests, preparedConfig, DateTimeOffset.UtcNow).Get();
+            timer.Stop();
+            Report("presign, batched", urls, timer);
+        }
+
+        static void ReportThroughput(string name, long bytes, Action op)
+        {
+            op();
+            var timer = Stopwatch.StartNew();
+            op();
+            timer.Stop();
+            double mbPerSecond = bytes / (1024.0 * 1024.0) / timer.Elapsed.TotalSeconds;
+            Console.WriteLine(String.Format("{0,-40} {1,12:N0} MB/s", name, mbPerSecond));
+        }
+    }
+}
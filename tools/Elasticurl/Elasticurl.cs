@@ -324,16 +324,24 @@ namespace Aws.Crt.Elasticurl
                     responseCodeWritten = true;
                 }
 
-                foreach (var header in e.Headers)
+                var headers = e.HeaderCollection;
+                for (int i = 0; i < headers.Count; ++i)
                 {
-                    Console.WriteLine("{0}:{1}", header.Name, header.Value);
+                    Console.WriteLine("{0}:{1}", headers.GetName(i), headers.GetValue(i));
                 }
             }
         }
 
+        static byte[] bodyBuffer = new byte[0];
+
         static void OnIncomingBody(object sender, IncomingBodyEventArgs e)
         {
-            ctx.OutputStream.Write(e.Data, 0, e.Data.Length);
+            if (bodyBuffer.Length < e.Length)
+            {
+                bodyBuffer = new byte[e.Length];
+            }
+            e.CopyTo(bodyBuffer, 0);
+            ctx.OutputStream.Write(bodyBuffer, 0, e.Length);
         }
 
         static void OnStreamComplete(object sender, StreamCompleteEventArgs e)
@@ -355,6 +363,7 @@ namespace Aws.Crt.Elasticurl
             HttpResponseStreamHandler responseHandler = new HttpResponseStreamHandler();
             responseHandler.IncomingHeaders += OnIncomingHeaders;
             responseHandler.IncomingBody += OnIncomingBody;
+            responseHandler.ReuseBodyEventArgs = true;
             responseHandler.StreamComplete += OnStreamComplete;
 
             return connection.MakeRequest(request, responseHandler);